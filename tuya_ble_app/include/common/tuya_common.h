@@ -67,6 +67,10 @@ extern "C" {
 #define STATIC static
 #endif
 
+#ifndef INLINE
+#define INLINE inline
+#endif
+
 #ifndef SIZEOF
 #define SIZEOF sizeof
 #endif
@@ -0,0 +1,83 @@
+/**
+ * @file tuya_encoder.h
+ * @author lifan
+ * @brief rotary encoder driver header file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __TUYA_ENCODER_H__
+#define __TUYA_ENCODER_H__
+
+#include "tuya_common.h"
+#include "tuya_gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef BYTE_T ENCODER_RET;
+#define ENCODER_OK                  0x00
+#define ENCODER_ERR_INVALID_PARM    0x01
+#define ENCODER_ERR_INVALID_STATE   0x02
+
+/* detents since the last report, > 0 - clockwise (A leads B); velocity in detents per second */
+typedef VOID_T (*ENCODER_CALLBACK)(INT_T detent, UINT_T velocity);
+
+typedef struct {                /* user define */
+    TY_GPIO_PORT_E port_a;      /* channel A */
+    TY_GPIO_PORT_E port_b;      /* channel B */
+    BOOL_T active_low;          /* common pin to ground, pull-up inputs? */
+    UCHAR_T step_per_detent;    /* quadrature steps per detent: 1, 2 or 4 */
+    ENCODER_CALLBACK encoder_cb;
+} ENCODER_DEF_T;
+
+typedef struct {
+    UINT_T edge_cnt;            /* edge interrupts */
+    UINT_T step_cnt;            /* valid quadrature steps */
+    UINT_T error_cnt;           /* invalid transitions, both channels changed: a step was missed */
+} ENCODER_STAT_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief encoder init, decodes on both edges of both channels in tuya_gpio_irq_handler()
+ * @param[in] encoder_def: user encoder define, referenced and must stay valid
+ * @return ENCODER_RET
+ */
+ENCODER_RET tuya_encoder_init(IN CONST ENCODER_DEF_T *encoder_def);
+
+/**
+ * @brief encoder loop, must be called in the main loop, reports the rotation to the callback
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_encoder_loop(VOID_T);
+
+/**
+ * @brief get encoder statistics
+ * @param[out] stat: encoder statistics
+ * @return none
+ */
+VOID_T tuya_encoder_get_stat(OUT ENCODER_STAT_T *stat);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __TUYA_ENCODER_H__ */
@@ -22,6 +22,37 @@ extern "C" {
 /***********************************************************
 ************************micro define************************
 ***********************************************************/
+#ifndef KEY_MAX_NUM
+#define KEY_MAX_NUM             8       /* size of the static key registry */
+#endif
+
+#define KEY_LONG_PRESS_LEVEL_MAX    8   /* max entries of a long press table */
+#define KEY_CLICK_MAX               3   /* max clicks of a multi-click gesture */
+#define KEY_CLICK_GAP_DEFAULT       300 /* default max gap between two clicks (ms) */
+#define KEY_CLICK_PRESS_MAX         1000 /* multi-click: a longer press is no click and ends the sequence (ms) */
+#define KEY_REPEAT_ACCEL_SHIFT      2   /* auto-repeat: each repeat shortens the interval by 1/4 */
+#define KEY_DEBOUNCE_TIME_MAX       320 /* max per-key debounce time (ms) */
+
+#ifndef KEY_CHORD_MAX_NUM
+#define KEY_CHORD_MAX_NUM       4       /* size of the static chord registry */
+#endif
+#define KEY_CHORD_KEY_MAX       4       /* max keys of a chord */
+
+#ifndef KEY_SRC_MAX_NUM
+#define KEY_SRC_MAX_NUM         2       /* max key sources other than gpio pins */
+#endif
+#define KEY_SRC_KEY_MAX         32      /* max keys of a key source */
+
+#ifndef KEY_SCAN_IDLE_DIV
+#define KEY_SCAN_IDLE_DIV       2       /* idle banks and key sources are sampled every n scan ticks, 1 - every tick */
+#endif
+
+#ifndef KEY_EVENT_QUEUE_SIZE
+#define KEY_EVENT_QUEUE_SIZE    16      /* key event queue depth, power of 2 */
+#endif
+
+/* number of entries of a key table defined as an array */
+#define KEY_TAB_SIZE(tab)       ((UCHAR_T)(SIZEOF(tab) / SIZEOF((tab)[0])))
 
 /***********************************************************
 ***********************typedef define***********************
@@ -30,21 +61,115 @@ typedef BYTE_T KEY_RET;
 #define KEY_OK                  0x00
 #define KEY_ERR_MALLOC_FAILED   0x01
 #define KEY_ERR_CB_UNDEFINED    0x02
+#define KEY_ERR_INVALID_PARM    0x03
+#define KEY_ERR_INVALID_STATE   0x04
+#define KEY_ERR_NO_RESOURCE     0x05
+
+typedef BYTE_T KEY_SCAN_MODE_E;
+#define KEY_SCAN_MODE_POLL      0x00    /* scan timer runs all the time */
+#define KEY_SCAN_MODE_EDGE      0x01    /* scan timer runs only after a key edge until all keys settled */
+
+typedef BYTE_T KEY_DEBOUNCE_E;
+#define KEY_DEBOUNCE_DEFAULT    0x00    /* 4 equal samples, shared by all default keys of a bank */
+#define KEY_DEBOUNCE_INTEGRATOR 0x01    /* count up while pressed and down while released, toggle at the limits */
+#define KEY_DEBOUNCE_SHIFT      0x02    /* toggle when all samples of the debounce time are equal */
+#define KEY_DEBOUNCE_LOCKOUT    0x03    /* toggle on the first changed sample, then ignore the debounce time */
 
 typedef BYTE_T KEY_PRESS_TYPE_E;
 #define SHORT_PRESS             0x00
 #define LONG_PRESS_FOR_TIME1    0x01
 #define LONG_PRESS_FOR_TIME2    0x02
+/* long press table level n (0 based), LONG_PRESS_FOR_TIME1 ~ LONG_PRESS_FOR_TIME1 + KEY_LONG_PRESS_LEVEL_MAX - 1 */
+#define LONG_PRESS_FOR_LEVEL(n) ((KEY_PRESS_TYPE_E)(LONG_PRESS_FOR_TIME1 + (n)))
+#define DOUBLE_CLICK            0x10
+#define TRIPLE_CLICK            0x11
+#define CHORD_PRESS             0x20    /* sent to the chord callback */
+#define HOLD_REPEAT             0x30    /* auto-repeat while the key is held */
+#define SHORT_PRESS_RETRACT     0x31    /* the SHORT_PRESS sent on press became a long press, repeat or chord */
+/* sent to the event callback only */
+#define KEY_DOWN                0x40    /* key pressed */
+#define KEY_UP                  0x41    /* key released, duration is the press duration */
+#define KEY_LEVEL_CROSSED       0x42    /* long press threshold crossed while held, level is the number reached */
 
 typedef VOID_T (*KEY_CALLBACK)(KEY_PRESS_TYPE_E type);
+
+/* registered key, stays valid until the key is unregistered */
+typedef UINT_T KEY_HANDLE;
+
+typedef struct {
+    KEY_PRESS_TYPE_E type;      /* key event type */
+    UCHAR_T level;              /* long press thresholds reached in this press */
+    UINT_T duration;            /* time the key has been held (ms) */
+    UINT_T time;                /* clock time when the event was detected, see tuya_get_clock_time() */
+} KEY_EVENT_T;
+typedef VOID_T (*KEY_EVENT_CALLBACK)(CONST KEY_EVENT_T *evt);
+
+/* key source, a group of keys sampled together in each scan tick, e.g. a matrix keypad */
+typedef UINT_T (*KEY_SRC_READ_CB)(VOID_T);  /* returns the raw key states, bit n - source key n, 1 - pressed */
+typedef struct {                /* user define */
+    KEY_SRC_READ_CB read;       /* read all keys of the source */
+    BOOL_T wakeup;              /* the source calls tuya_key_wakeup() on a press? FALSE - polled (edge mode) */
+} KEY_SRC_T;
+
 typedef struct {                /* user define */
     TY_GPIO_PORT_E port;        /* key port */
     BOOL_T active_low;          /* key detection is active low? */
     UINT_T long_press_time1;    /* key long press time1 set (ms) */
     UINT_T long_press_time2;    /* key long press time2 set (ms) */
-    KEY_CALLBACK key_cb;        /* key press callback function */
+    KEY_CALLBACK key_cb;        /* key press callback function, only used without evt_cb */
+    CONST UINT_T *long_press_tab;   /* optional long press times in ascending order (ms), replaces time1 and time2 */
+    UCHAR_T long_press_num;         /* number of entries in long_press_tab, 0 - not used */
+    UCHAR_T click_max;              /* multi-click: 0/1 - off, 2 - up to DOUBLE_CLICK, 3 - up to TRIPLE_CLICK */
+    UINT_T click_gap;               /* multi-click: max release to press gap (ms), 0 - KEY_CLICK_GAP_DEFAULT */
+    CONST KEY_SRC_T *src;           /* key source, NULL - gpio key on port */
+    UCHAR_T src_bit;                /* key number in the source, port and active_low are not used */
+    UINT_T repeat_delay;            /* auto-repeat: first HOLD_REPEAT after the press (ms), 0 - off */
+    UINT_T repeat_intv;             /* auto-repeat: initial repeat interval (ms) */
+    UINT_T repeat_intv_min;         /* auto-repeat: accelerates down to this interval, the rate cap (ms), 0 - no acceleration */
+    KEY_EVENT_CALLBACK evt_cb;      /* key event callback function with KEY_DOWN, KEY_UP and KEY_LEVEL_CROSSED,
+                                       NULL - key_cb receives the press types only */
+    KEY_DEBOUNCE_E debounce;        /* debounce algorithm */
+    UINT_T debounce_ms;             /* debounce time of a non-default algorithm, in scan cycles (ms),
+                                       also replaces the 50 ms min press time */
+    UINT_T debounce_min_ms;         /* adaptive debounce: bounds of the learned debounce time (ms), */
+    UINT_T debounce_max_ms;         /* 0 - debounce_ms is fixed, non-default algorithms only */
+    BOOL_T short_press_early;       /* send SHORT_PRESS on press although long presses or repeat are set,
+                                       SHORT_PRESS_RETRACT follows if the press goes on, no multi-click */
 } KEY_DEF_T;
 
+typedef struct {                /* user define */
+    CONST KEY_DEF_T *keys[KEY_CHORD_KEY_MAX];   /* registered keys of the chord, unused entries NULL */
+    UINT_T hold_time;           /* time all keys must be held together (ms) */
+    BOOL_T suppress;            /* suppress the key events of its keys once the chord is complete,
+                                   their SHORT_PRESS is then sent on release */
+    KEY_CALLBACK chord_cb;      /* chord callback function, receives CHORD_PRESS */
+} KEY_CHORD_DEF_T;
+
+typedef struct {
+    UINT_T scan_cnt;            /* scan timer wakeups */
+    UINT_T wakeup_cnt;          /* key edge interrupts and key source wakeups */
+    UINT_T evt_overflow_cnt;    /* key events dropped because the queue was full */
+    UINT_T evt_depth_max;       /* max number of key events waiting in the queue */
+    UINT_T tick_cost_last;      /* last scan tick (clock ticks of tuya_get_clock_time()) */
+    UINT_T tick_cost_max;       /* longest scan tick (clock ticks of tuya_get_clock_time()) */
+    UINT_T bank_skip_cnt;       /* idle bank and key source samples skipped by the scan scheduler */
+    UINT_T tick_drift_last;     /* how late the last scan tick was (ms) */
+    UINT_T tick_drift_max;      /* max lateness of a scan tick (ms) */
+    UINT_T click_delay_last;    /* last multi-click event delay after the final release (ms) */
+    UINT_T click_delay_max;     /* max multi-click event delay after the final release (ms) */
+    UINT_T early_gain_last;     /* last SHORT_PRESS sent on press: time gained before the release (ms) */
+    UINT_T early_gain_max;      /* max time gained by a SHORT_PRESS sent on press (ms) */
+    UINT_T retract_cnt;         /* SHORT_PRESS_RETRACT events */
+} KEY_SCAN_STAT_T;
+
+typedef struct {
+    UINT_T edge_cnt_last;       /* raw edges of the last transition */
+    UINT_T edge_cnt_max;        /* max raw edges of a transition */
+    UINT_T span_last;           /* first to last raw edge of the last transition (ms) */
+    UINT_T span_max;            /* max first to last raw edge of a transition (ms) */
+    UINT_T debounce_ms;         /* debounce time in use, learned in adaptive mode (ms) */
+} KEY_BOUNCE_STAT_T;
+
 /***********************************************************
 ***********************variable define**********************
 ***********************************************************/
@@ -59,6 +184,48 @@ typedef struct {                /* user define */
  */
 KEY_RET tuya_reg_key(IN KEY_DEF_T* key_def);
 
+/**
+ * @brief key table register, no heap is used and the table is referenced,
+ *        so it must stay valid (a const table can be placed in flash)
+ * @param[in] key_tab: user key define table
+ * @param[in] key_num: number of keys in the table, see KEY_TAB_SIZE()
+ * @return KEY_RET
+ */
+KEY_RET tuya_reg_key_table(IN CONST KEY_DEF_T *key_tab, IN CONST UCHAR_T key_num);
+
+/**
+ * @brief get the handle of a registered key
+ * @param[in] key_def: registered key define
+ * @param[out] handle: key handle
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_get_handle(IN CONST KEY_DEF_T *key_def, OUT KEY_HANDLE *handle);
+
+/**
+ * @brief key unregister, the other keys keep their status,
+ *        a key of a chord cannot be unregistered
+ * @param[in] handle: key handle
+ * @return KEY_RET
+ */
+KEY_RET tuya_unreg_key(IN CONST KEY_HANDLE handle);
+
+/**
+ * @brief key update, replaces the define of a registered key, the other keys keep their status,
+ *        events of the old define still queued are dropped and a held key is seen as a new press,
+ *        on an error the old define is kept
+ * @param[in] handle: key handle, stays valid
+ * @param[in] key_def: new user key define, referenced and must stay valid
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_update(IN CONST KEY_HANDLE handle, IN CONST KEY_DEF_T *key_def);
+
+/**
+ * @brief key chord register, its keys must be registered first and the define is referenced
+ * @param[in] chord_def: user chord define
+ * @return KEY_RET
+ */
+KEY_RET tuya_reg_key_chord(IN CONST KEY_CHORD_DEF_T *chord_def);
+
 /**
  * @brief key reset
  * @param[in] none
@@ -66,6 +233,49 @@ KEY_RET tuya_reg_key(IN KEY_DEF_T* key_def);
  */
 KEY_RET tuya_key_reset(VOID_T);
 
+/**
+ * @brief key set scan mode, must be called before the first key is registered
+ * @param[in] mode: KEY_SCAN_MODE_POLL or KEY_SCAN_MODE_EDGE
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_set_scan_mode(IN CONST KEY_SCAN_MODE_E mode);
+
+/**
+ * @brief request a key scan, called by a key source on a key edge, safe in interrupt context
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_wakeup(VOID_T);
+
+/**
+ * @brief key loop, must be called in the main loop, executes the key callbacks
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_loop(VOID_T);
+
+/**
+ * @brief get key scan statistics
+ * @param[out] stat: scan statistics
+ * @return none
+ */
+VOID_T tuya_key_get_scan_stat(OUT KEY_SCAN_STAT_T *stat);
+
+/**
+ * @brief clear key scan statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_clr_scan_stat(VOID_T);
+
+/**
+ * @brief get bounce statistics of a key with a non-default debounce algorithm
+ * @param[in] key_def: registered key define
+ * @param[out] stat: bounce statistics
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_get_bounce_stat(IN CONST KEY_DEF_T *key_def, OUT KEY_BOUNCE_STAT_T *stat);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,86 @@
+/**
+ * @file tuya_key_adc.h
+ * @author lifan
+ * @brief adc resistor ladder key driver header file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __TUYA_KEY_ADC_H__
+#define __TUYA_KEY_ADC_H__
+
+#include "tuya_common.h"
+#include "tuya_gpio.h"
+#include "tuya_key.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_ADC_KEY_MAX         8       /* max keys of the ladder */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {                /* user define */
+    TY_GPIO_PORT_E port;        /* adc input of the ladder */
+    CONST UINT_T *key_mv;       /* voltage when key n is pressed (mV), src_bit of key n is n */
+    UCHAR_T key_num;
+    UINT_T idle_mv;             /* voltage when no key is pressed (mV) */
+    UINT_T margin_mv;           /* noise margin around each voltage (mV), windows must not overlap */
+} KEY_ADC_DEF_T;
+
+typedef struct {
+    UINT_T sample_cnt;          /* adc samples */
+    UINT_T guard_cnt;           /* samples outside all windows, e.g. while a key moves */
+    UINT_T mv_last;             /* last sampled voltage (mV) */
+} KEY_ADC_STAT_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief adc ladder init, the define is referenced and must stay valid,
+ *        the keys are then registered with a KEY_SRC_T of tuya_key_adc_read(),
+ *        it has no edge interrupt, so the key source is polled (wakeup FALSE)
+ * @param[in] adc_def: user adc ladder define
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_adc_init(IN CONST KEY_ADC_DEF_T *adc_def);
+
+/**
+ * @brief adc ladder read, one sample for all keys, used as the read function of the key source
+ * @param[in] none
+ * @return key states, bit n - key n, 1 - pressed
+ */
+UINT_T tuya_key_adc_read(VOID_T);
+
+/**
+ * @brief get adc ladder statistics
+ * @param[out] stat: adc ladder statistics
+ * @return none
+ */
+VOID_T tuya_key_adc_get_stat(OUT KEY_ADC_STAT_T *stat);
+
+/**
+ * @brief clear adc ladder statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_adc_clr_stat(VOID_T);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __TUYA_KEY_ADC_H__ */
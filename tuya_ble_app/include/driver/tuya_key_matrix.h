@@ -0,0 +1,89 @@
+/**
+ * @file tuya_key_matrix.h
+ * @author lifan
+ * @brief matrix keypad driver header file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __TUYA_KEY_MATRIX_H__
+#define __TUYA_KEY_MATRIX_H__
+
+#include "tuya_common.h"
+#include "tuya_gpio.h"
+#include "tuya_key.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_MATRIX_ROW_MAX      8
+#define KEY_MATRIX_COL_MAX      TY_GPIO_BANK_PIN_NUM    /* columns are read with one bank read */
+
+/* src_bit of the matrix key at row and col */
+#define KEY_MATRIX_BIT(row, col, col_num)   ((UCHAR_T)((row) * (col_num) + (col)))
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {                /* user define */
+    CONST TY_GPIO_PORT_E *row_port;     /* row outputs, driven low to select a row */
+    UCHAR_T row_num;
+    CONST TY_GPIO_PORT_E *col_port;     /* column inputs with pull-up, all in one gpio bank */
+    UCHAR_T col_num;
+} KEY_MATRIX_DEF_T;
+
+typedef struct {
+    UINT_T sweep_cnt;           /* full matrix sweeps */
+    UINT_T ghost_cnt;           /* sweeps dropped because of ghost keys */
+    UINT_T sweep_cost_last;     /* last sweep (clock ticks of tuya_get_clock_time()) */
+    UINT_T sweep_cost_max;      /* longest sweep (clock ticks of tuya_get_clock_time()) */
+} KEY_MATRIX_STAT_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief matrix keypad init, the define is referenced and must stay valid,
+ *        the keys are then registered with a KEY_SRC_T of tuya_key_matrix_read()
+ * @param[in] matrix_def: user matrix define
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_matrix_init(IN CONST KEY_MATRIX_DEF_T *matrix_def);
+
+/**
+ * @brief matrix keypad read, sweeps all rows, used as the read function of the key source
+ * @param[in] none
+ * @return key states, bit KEY_MATRIX_BIT(row, col, col_num), 1 - pressed
+ */
+UINT_T tuya_key_matrix_read(VOID_T);
+
+/**
+ * @brief get matrix keypad statistics
+ * @param[out] stat: matrix statistics
+ * @return none
+ */
+VOID_T tuya_key_matrix_get_stat(OUT KEY_MATRIX_STAT_T *stat);
+
+/**
+ * @brief clear matrix keypad statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_matrix_clr_stat(VOID_T);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __TUYA_KEY_MATRIX_H__ */
@@ -0,0 +1,83 @@
+/**
+ * @file tuya_key_touch.h
+ * @author lifan
+ * @brief capacitive touch key driver header file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __TUYA_KEY_TOUCH_H__
+#define __TUYA_KEY_TOUCH_H__
+
+#include "tuya_common.h"
+#include "tuya_key.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_TOUCH_CH_MAX            16      /* max touch channels */
+#define KEY_TOUCH_BASE_UPDATE_NUM   4       /* baselines updated per scan tick, bounds the tick cost */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef UINT_T (*KEY_TOUCH_READ_CB)(UCHAR_T ch);   /* returns the raw count of the channel (< 2^24), rises when touched */
+
+typedef struct {                /* user define */
+    KEY_TOUCH_READ_CB read;     /* raw count read function */
+    UCHAR_T ch_num;             /* number of channels, src_bit of channel n is n */
+    UINT_T touch_delta;         /* count above the baseline to detect a touch */
+    UINT_T release_delta;       /* count above the baseline to keep a touch, less than touch_delta */
+    UCHAR_T baseline_shift;     /* baseline follows 1/2^n of a rise, 1/2^(n/2) of a fall per update, 0 - 8 */
+} KEY_TOUCH_DEF_T;
+
+typedef struct {
+    UINT_T count;               /* last raw count */
+    UINT_T baseline;            /* tracked baseline */
+    BOOL_T touched;
+} KEY_TOUCH_CH_INFO_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief touch keys init, the define is referenced and must stay valid, the baselines start
+ *        from the first counts, the keys are then registered with a KEY_SRC_T of tuya_key_touch_read(),
+ *        the channels are polled (wakeup FALSE)
+ * @param[in] touch_def: user touch define
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_touch_init(IN CONST KEY_TOUCH_DEF_T *touch_def);
+
+/**
+ * @brief touch keys read, reads all channels and updates some baselines,
+ *        used as the read function of the key source
+ * @param[in] none
+ * @return key states, bit n - channel n, 1 - touched
+ */
+UINT_T tuya_key_touch_read(VOID_T);
+
+/**
+ * @brief get touch channel information
+ * @param[in] ch: channel
+ * @param[out] info: channel information
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_touch_get_ch_info(IN CONST UCHAR_T ch, OUT KEY_TOUCH_CH_INFO_T *info);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __TUYA_KEY_TOUCH_H__ */
@@ -0,0 +1,58 @@
+/**
+ * @file tuya_adc.h
+ * @author lifan
+ * @brief tuya adc header file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __TUYA_ADC_H__
+#define __TUYA_ADC_H__
+
+#include "tuya_common.h"
+#include "tuya_gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef BYTE_T ADC_RET;
+#define ADC_OK                  0x00
+#define ADC_ERR_INVALID_PARM    0x01
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief tuya adc init, one adc input at a time
+ * @param[in] port: adc input pin, TY_GPIOB_0 ~ TY_GPIOB_7, TY_GPIOC_4 or TY_GPIOC_5
+ * @return ADC_RET
+ */
+ADC_RET tuya_adc_init(IN CONST TY_GPIO_PORT_E port);
+
+/**
+ * @brief tuya adc read
+ * @param[in] none
+ * @return input voltage (mV)
+ */
+UINT_T tuya_adc_read_mv(VOID_T);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __TUYA_ADC_H__ */
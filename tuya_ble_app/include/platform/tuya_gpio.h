@@ -13,6 +13,7 @@
 #define __TUYA_GPIO_H__
 
 #include "tuya_common.h"
+#include "tuya_timer.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -27,6 +28,12 @@ typedef BYTE_T GPIO_RET;
 #define GPIO_ERR_MALLOC_FAILED  0x02
 #define GPIO_ERR_CB_UNDEFINED   0x03
 
+#ifndef TY_GPIO_EDGE_FIFO_SIZE
+#define TY_GPIO_EDGE_FIFO_SIZE  16      /* edge fifo depth, power of 2 */
+#endif
+
+#define TY_GPIO_HOLDOFF_DIV     4       /* hold-off timer ticks per hold-off time, the hold-off lasts up to 1/4 longer */
+
 /***********************************************************
 ***********************typedef define***********************
 ***********************************************************/
@@ -71,13 +78,48 @@ typedef BYTE_T TY_GPIO_MODE_E;
 #define TY_GPIO_PULLDOWN    0x01
 #define TY_GPIO_FLOATING    0x02
 
+/* the polarity of an interrupt pin follows its level, so a rising or falling pin also takes an
+   interrupt on the other edge, twice the rate of its dispatched edges, that edge is not dispatched */
 typedef BYTE_T TY_GPIO_IRQ_TYPE_E;
 #define TY_GPIO_IRQ_NONE    0x00
 #define TY_GPIO_IRQ_RISING  0x01
 #define TY_GPIO_IRQ_FALLING 0x02
+#define TY_GPIO_IRQ_BOTH    0x03    /* both edges, the polarity follows the pin level */
 
 typedef VOID_T (*TY_GPIO_IRQ_CB)(TY_GPIO_PORT_E port);
 
+typedef BYTE_T TY_GPIO_BANK_E;
+#define TY_GPIO_BANK_A      0x00
+#define TY_GPIO_BANK_B      0x01
+#define TY_GPIO_BANK_C      0x02
+#define TY_GPIO_BANK_D      0x03
+#define TY_GPIO_BANK_MAX    0x04
+
+#define TY_GPIO_BANK_PIN_NUM        8
+#define TY_GPIO_PORT_TO_BANK(port)  ((TY_GPIO_BANK_E)((port) >> 3))
+#define TY_GPIO_PORT_TO_BIT(port)   ((port) & 0x07)
+#define TY_GPIO_PORT_TO_MASK(port)  ((UCHAR_T)(1 << TY_GPIO_PORT_TO_BIT(port)))  /* pin mask in its bank */
+
+typedef struct {
+    UINT_T irq_cnt;             /* gpio interrupts handled */
+    UINT_T holdoff_cnt;         /* pin interrupts masked after an edge */
+    UINT_T suppress_cnt;        /* hold-offs that hid at least one edge: an edge was latched meanwhile
+                                   or the pin level changed, a burst back to the same level included */
+} TY_GPIO_HOLDOFF_STAT_T;
+
+/* resolved pin, see tuya_gpio_pin_get() */
+typedef struct {
+    volatile UCHAR_T *in;       /* input register of the pin bank */
+    volatile UCHAR_T *out;      /* output register of the pin bank */
+    UCHAR_T mask;               /* pin bit in the bank */
+} TY_GPIO_PIN_T;
+
+typedef struct {
+    TY_GPIO_PORT_E port;
+    BOOL_T level;               /* pin level after the edge */
+    UINT_T time;                /* clock time of the edge interrupt, see tuya_get_clock_time() */
+} TY_GPIO_EDGE_T;
+
 /***********************************************************
 ***********************variable define**********************
 ***********************************************************/
@@ -133,6 +175,79 @@ GPIO_RET tuya_gpio_write(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T level);
  */
 BOOL_T tuya_gpio_read(IN CONST TY_GPIO_PORT_E port);
 
+/**
+ * @brief tuya gpio resolve a pin, checked once for tuya_gpio_pin_read() and tuya_gpio_pin_write()
+ * @param[in] port: gpio number
+ * @param[out] pin: resolved pin
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_pin_get(IN CONST TY_GPIO_PORT_E port, OUT TY_GPIO_PIN_T *pin);
+
+/**
+ * @brief tuya gpio read a resolved pin, no checks, one register read
+ * @param[in] pin: resolved pin
+ * @return TRUE - high level, FALSE - low level
+ */
+STATIC INLINE BOOL_T tuya_gpio_pin_read(IN CONST TY_GPIO_PIN_T *pin)
+{
+    return (*pin->in & pin->mask) ? TRUE : FALSE;
+}
+
+/**
+ * @brief tuya gpio write a resolved pin, no checks, one register write
+ * @param[in] pin: resolved pin
+ * @param[in] level: output level
+ * @return none
+ */
+STATIC INLINE VOID_T tuya_gpio_pin_write(IN CONST TY_GPIO_PIN_T *pin, IN CONST BOOL_T level)
+{
+    if (level) {
+        *pin->out |= pin->mask;
+    } else {
+        *pin->out &= ~pin->mask;
+    }
+}
+
+/**
+ * @brief tuya gpio read bank
+ * @param[in] bank: gpio bank
+ * @return input levels of the bank, bit n is the level of pin n (TY_GPIOx_n)
+ */
+UCHAR_T tuya_gpio_read_bank(IN CONST TY_GPIO_BANK_E bank);
+
+/**
+ * @brief tuya gpio set the output of the bank pins in the mask to high, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to set, bit n - pin n (TY_GPIOx_n), see TY_GPIO_PORT_TO_MASK()
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_set_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask);
+
+/**
+ * @brief tuya gpio set the output of the bank pins in the mask to low, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to clear, bit n - pin n (TY_GPIOx_n)
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_clr_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask);
+
+/**
+ * @brief tuya gpio toggle the output of the bank pins in the mask, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to toggle, bit n - pin n (TY_GPIOx_n)
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_toggle_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask);
+
+/**
+ * @brief tuya gpio write the output of the bank pins in the mask, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to write, bit n - pin n (TY_GPIOx_n)
+ * @param[in] level: output levels, bit n - level of pin n
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_write_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask, IN CONST UCHAR_T level);
+
 /**
  * @brief tuya gpio interrupt init
  * @param[in] port: gpio number
@@ -142,6 +257,77 @@ BOOL_T tuya_gpio_read(IN CONST TY_GPIO_PORT_E port);
  */
 GPIO_RET tuya_gpio_irq_init(IN CONST TY_GPIO_PORT_E port, IN CONST TY_GPIO_IRQ_TYPE_E trig_type, IN TY_GPIO_IRQ_CB irq_cb);
 
+/**
+ * @brief tuya gpio interrupt deinit
+ * @param[in] port: gpio number
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_deinit(IN CONST TY_GPIO_PORT_E port);
+
+/**
+ * @brief tuya gpio edge init, both edges of the port are timestamped in the interrupt
+ *        and queued in one fifo shared by all edge ports, in the order they happened
+ * @param[in] port: gpio number
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_edge_init(IN CONST TY_GPIO_PORT_E port);
+
+/**
+ * @brief tuya gpio interrupt enable of a port, the interrupt setting is kept while disabled,
+ *        the edges while disabled are not reported
+ * @param[in] port: gpio number with an interrupt
+ * @param[in] enable: TRUE - enable, FALSE - disable
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_set_enable(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T enable);
+
+/**
+ * @brief get the oldest queued edge, single consumer
+ * @param[out] edge: gpio edge
+ * @return TRUE - an edge was queued, FALSE - fifo empty
+ */
+BOOL_T tuya_gpio_edge_get(OUT TY_GPIO_EDGE_T *edge);
+
+/**
+ * @brief get the number of edges lost because the edge fifo was full
+ * @param[in] none
+ * @return lost edges
+ */
+UINT_T tuya_gpio_edge_get_lost_cnt(VOID_T);
+
+/**
+ * @brief tuya gpio interrupt hold-off init: a pin with hold-off is masked for the hold-off time after
+ *        each edge, its interrupt is enabled again from the hardware timer, called once,
+ *        the plain gpio interrupt channel (FLD_IRQ_GPIO_EN) latches the edges of the masked pins
+ * @param[in] timer: hardware timer used for the hold-off
+ * @param[in] holdoff_us: hold-off time (us)
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_holdoff_init(IN CONST TY_HW_TIMER_TYPE_E timer, IN CONST UINT_T holdoff_us);
+
+/**
+ * @brief tuya gpio interrupt hold-off of a port, limits the interrupt rate of a bouncing pin,
+ *        a pin whose level changed meanwhile gets one edge to the final level
+ * @param[in] port: gpio number
+ * @param[in] enable: TRUE - hold-off after each edge, FALSE - every edge interrupts
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_set_holdoff(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T enable);
+
+/**
+ * @brief get gpio interrupt hold-off statistics
+ * @param[out] stat: hold-off statistics
+ * @return none
+ */
+VOID_T tuya_gpio_get_holdoff_stat(OUT TY_GPIO_HOLDOFF_STAT_T *stat);
+
+/**
+ * @brief clear gpio interrupt hold-off statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_gpio_clr_holdoff_stat(VOID_T);
+
 /*
  * @brief tuya gpio irq handler
  * @param[in] none
@@ -124,6 +124,14 @@ UINT_T tuya_get_clock_time(VOID_T);
  */
 BOOL_T tuya_is_clock_time_exceed(IN CONST UINT_T prv_time, IN CONST UINT_T time_diff_us);
 
+/**
+ * @brief tuya get clock time difference, handles the clock wraparound
+ * @param[in] prv_time: previous clock time
+ * @param[in] cur_time: current clock time
+ * @return time difference (us)
+ */
+UINT_T tuya_get_clock_time_diff_us(IN CONST UINT_T prv_time, IN CONST UINT_T cur_time);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,174 @@
+/**
+ * @file tuya_encoder.c
+ * @author lifan
+ * @brief rotary encoder driver source file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "tuya_encoder.h"
+#include "tuya_timer.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define ENCODER_STEP_ERR        2       /* transition table: both channels changed */
+#define ENCODER_VELOCITY_MIN_US 1000000 /* detent interval reported as 1 detent per second or slower */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+/* quadrature step of each transition, index: previous AB << 2 | current AB */
+STATIC CONST SCHAR_T sg_encoder_step_tab[16] = {
+     0, -1,  1, ENCODER_STEP_ERR,
+     1,  0, ENCODER_STEP_ERR, -1,
+    -1, ENCODER_STEP_ERR,  0,  1,
+    ENCODER_STEP_ERR,  1, -1,  0
+};
+
+STATIC CONST ENCODER_DEF_T *sg_encoder_def = NULL;
+STATIC TY_GPIO_PIN_T sg_encoder_pin_a;
+STATIC TY_GPIO_PIN_T sg_encoder_pin_b;
+/* written by the interrupt only */
+STATIC volatile UCHAR_T sg_encoder_ab = 0;
+STATIC volatile SCHAR_T sg_encoder_step = 0;       /* steps within the current detent */
+STATIC volatile UINT_T sg_encoder_detent = 0;      /* detent counter, wraps */
+STATIC volatile UINT_T sg_encoder_detent_time = 0; /* clock time of the last detent */
+STATIC volatile UINT_T sg_encoder_detent_intv = 0; /* clock time between the last two detents */
+STATIC volatile ENCODER_STAT_T sg_encoder_stat = {0};
+/* written by the loop only */
+STATIC UINT_T sg_encoder_detent_read = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief read channel A and B
+ * @param[in] none
+ * @return bit 1 - A, bit 0 - B, 1 - active
+ */
+STATIC UCHAR_T __encoder_ab_read(VOID_T)
+{
+    UCHAR_T ab = (tuya_gpio_pin_read(&sg_encoder_pin_a) ? 0x02 : 0x00) |
+                 (tuya_gpio_pin_read(&sg_encoder_pin_b) ? 0x01 : 0x00);
+
+    return sg_encoder_def->active_low ? (ab ^ 0x03) : ab;
+}
+
+/**
+ * @brief channel edge interrupt callback, one table lookup per edge
+ * @param[in] port: channel port
+ * @return none
+ */
+STATIC VOID_T __encoder_irq_cb(TY_GPIO_PORT_E port)
+{
+    UCHAR_T ab = __encoder_ab_read();
+    SCHAR_T step = sg_encoder_step_tab[(sg_encoder_ab << 2) | ab];
+    UINT_T now;
+
+    sg_encoder_stat.edge_cnt++;
+    sg_encoder_ab = ab;
+    if (ENCODER_STEP_ERR == step) {
+        sg_encoder_stat.error_cnt++;
+        return;
+    }
+    if (0 == step) {
+        return;
+    }
+    sg_encoder_stat.step_cnt++;
+    sg_encoder_step += step;
+    if ((sg_encoder_step >= (SCHAR_T)sg_encoder_def->step_per_detent) ||
+        (sg_encoder_step <= -(SCHAR_T)sg_encoder_def->step_per_detent)) {
+        if (sg_encoder_step > 0) {
+            sg_encoder_detent++;
+        } else {
+            sg_encoder_detent--;
+        }
+        sg_encoder_step = 0;
+        now = tuya_get_clock_time();
+        sg_encoder_detent_intv = now - sg_encoder_detent_time;
+        sg_encoder_detent_time = now;
+    }
+}
+
+/**
+ * @brief encoder init, decodes on both edges of both channels in tuya_gpio_irq_handler()
+ * @param[in] encoder_def: user encoder define, referenced and must stay valid
+ * @return ENCODER_RET
+ */
+ENCODER_RET tuya_encoder_init(IN CONST ENCODER_DEF_T *encoder_def)
+{
+    if (sg_encoder_def != NULL) {
+        return ENCODER_ERR_INVALID_STATE;
+    }
+    if ((NULL == encoder_def) || (NULL == encoder_def->encoder_cb) || (encoder_def->port_a == encoder_def->port_b)) {
+        return ENCODER_ERR_INVALID_PARM;
+    }
+    if ((encoder_def->step_per_detent != 1) && (encoder_def->step_per_detent != 2) && (encoder_def->step_per_detent != 4)) {
+        return ENCODER_ERR_INVALID_PARM;
+    }
+    if ((GPIO_OK != tuya_gpio_init(encoder_def->port_a, TRUE, encoder_def->active_low)) ||
+        (GPIO_OK != tuya_gpio_init(encoder_def->port_b, TRUE, encoder_def->active_low))) {
+        return ENCODER_ERR_INVALID_PARM;
+    }
+    /* read in the interrupt without the port checks */
+    tuya_gpio_pin_get(encoder_def->port_a, &sg_encoder_pin_a);
+    tuya_gpio_pin_get(encoder_def->port_b, &sg_encoder_pin_b);
+
+    sg_encoder_def = encoder_def;
+    sg_encoder_ab = __encoder_ab_read();
+    sg_encoder_step = 0;
+    sg_encoder_detent_time = tuya_get_clock_time();
+    if (GPIO_OK != tuya_gpio_irq_init(encoder_def->port_a, TY_GPIO_IRQ_BOTH, __encoder_irq_cb)) {
+        sg_encoder_def = NULL;
+        return ENCODER_ERR_INVALID_PARM;
+    }
+    if (GPIO_OK != tuya_gpio_irq_init(encoder_def->port_b, TY_GPIO_IRQ_BOTH, __encoder_irq_cb)) {
+        tuya_gpio_irq_deinit(encoder_def->port_a);
+        sg_encoder_def = NULL;
+        return ENCODER_ERR_INVALID_PARM;
+    }
+    return ENCODER_OK;
+}
+
+/**
+ * @brief encoder loop, must be called in the main loop, reports the rotation to the callback
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_encoder_loop(VOID_T)
+{
+    UINT_T detent, intv_us, velocity;
+
+    if (NULL == sg_encoder_def) {
+        return;
+    }
+    detent = sg_encoder_detent;
+    if (detent == sg_encoder_detent_read) {
+        return;
+    }
+    /* velocity from the interval between the last two detents */
+    intv_us = tuya_get_clock_time_diff_us(0, sg_encoder_detent_intv);
+    velocity = ((intv_us == 0) || (intv_us >= ENCODER_VELOCITY_MIN_US)) ? 1 : (1000000 / intv_us);
+    sg_encoder_def->encoder_cb((INT_T)(detent - sg_encoder_detent_read), velocity);
+    sg_encoder_detent_read = detent;
+}
+
+/**
+ * @brief get encoder statistics
+ * @param[out] stat: encoder statistics
+ * @return none
+ */
+VOID_T tuya_encoder_get_stat(OUT ENCODER_STAT_T *stat)
+{
+    stat->edge_cnt = sg_encoder_stat.edge_cnt;
+    stat->step_cnt = sg_encoder_stat.step_cnt;
+    stat->error_cnt = sg_encoder_stat.error_cnt;
+}
@@ -10,7 +10,6 @@
  */
 
 #include "tuya_key.h"
-#include "tuya_ble_mem.h"
 #include "tuya_timer.h"
 
 /***********************************************************
@@ -18,29 +17,139 @@
 ***********************************************************/
 #define KEY_SCAN_CYCLE_MS       10
 #define KEY_PRESS_SHORT_TIME    50
+#define KEY_DEBOUNCE_CNT        4       /* fixed by the 2-bit vertical counter */
+#define KEY_TIME_NEVER          0xFFFFFFFF
+#define KEY_BOUNCE_AVG_SHIFT    2       /* adaptive debounce: span average weight of a new transition 1/4 */
+#define KEY_BOUNCE_AVG_Q        4       /* adaptive debounce: span average fraction bits */
+#define KEY_CHORD_ID_FLAG       0x80    /* event key id of a chord: KEY_CHORD_ID_FLAG | chord id */
+#define KEY_ID_NONE             0x7F    /* no key, event key id of a dropped event */
+#define KEY_HANDLE_ID_MASK      0xFF    /* key handle: generation << 8 | key id */
+#define KEY_EVENT_QUEUE_MASK    (KEY_EVENT_QUEUE_SIZE - 1)
+#define KEY_BANK_NUM            (TY_GPIO_BANK_MAX + KEY_SRC_MAX_NUM)    /* gpio banks, then key sources */
+#define KEY_BANK_BIT_NUM        32
+
+#if (KEY_EVENT_QUEUE_SIZE & KEY_EVENT_QUEUE_MASK) || (KEY_EVENT_QUEUE_SIZE > 128)
+#error "KEY_EVENT_QUEUE_SIZE must be a power of 2 and no more than 128"
+#endif
+
+#if (KEY_SCAN_IDLE_DIV == 0)
+#error "KEY_SCAN_IDLE_DIV must be at least 1"
+#endif
+
+#if (KEY_MAX_NUM > 32)
+#error "KEY_MAX_NUM must be no more than 32, keys are tracked in 32-bit masks"
+#endif
 
 /***********************************************************
 ***********************typedef define***********************
 ***********************************************************/
 /* Key status */
 typedef struct {
-    BOOL_T cur_stat;
-    BOOL_T prv_stat;
-    UINT_T cur_time;
-    UINT_T prv_time;
+    BOOL_T cur_stat;            /* debounced status, TRUE - press */
+    UCHAR_T level_idx;          /* number of plan thresholds reached in this press */
+    UINT_T press_time;          /* key time base when pressed (ms) */
+    UINT_T hold_time;           /* time since the key was pressed (ms) */
+    UINT_T next_time;           /* next plan threshold (ms) */
+    UINT_T release_time;        /* key time base when released (ms) */
+    UCHAR_T click_cnt;          /* clicks waiting for the click window to close */
+    BOOL_T repeated;            /* auto-repeat fired in this press */
+    UINT_T repeat_time;         /* hold time of the next auto-repeat (ms) */
+    UINT_T repeat_intv;         /* current auto-repeat interval (ms) */
+    UINT_T db_hist;             /* debounce: sample history, bit 0 - last sample */
+    UCHAR_T db_cnt;             /* debounce: integrator count or lockout ticks left */
+    BOOL_T db_raw;              /* debounce: last sample */
+    UCHAR_T bounce_edges;       /* raw edges of the transition being debounced */
+    UINT_T bounce_first;        /* key time base of its first raw edge (ms) */
+    UINT_T bounce_last;         /* key time base of its last raw edge (ms) */
+    UINT_T bounce_avg;          /* average transition span (ticks, KEY_BOUNCE_AVG_Q fraction bits) */
+    BOOL_T early_fired;         /* SHORT_PRESS sent on press, not retracted */
+    UINT_T early_time;          /* hold time when it was sent (ms) */
 } KEY_STATUS_T;
 
-/* Key manage */
-typedef struct key_manage_s {
-    struct key_manage_s *next;
-    KEY_DEF_T *key_def_s;
-    KEY_STATUS_T key_status_s;
-} KEY_MANAGE_T;
+/* Key decision plan, computed once at registration */
+typedef struct {
+    CONST UINT_T *level_time;                               /* thresholds in ascending order (ms) */
+    KEY_PRESS_TYPE_E level_type[KEY_LONG_PRESS_LEVEL_MAX];  /* event type of each threshold */
+    UCHAR_T level_num;
+    UCHAR_T level_base;                                     /* 1 - the first threshold is the short press */
+    UINT_T legacy_time[2];                                  /* thresholds of the two-level define */
+    UCHAR_T click_max;                                      /* 1 - single click only */
+    UINT_T click_gap;                                       /* max release to press gap (ms) */
+    UINT_T repeat_delay;                                    /* KEY_TIME_NEVER - no auto-repeat */
+    UINT_T repeat_intv;
+    UINT_T repeat_intv_min;
+    KEY_DEBOUNCE_E debounce;
+    UCHAR_T debounce_num;                                   /* debounce time in scan ticks */
+    UCHAR_T debounce_min_num;                               /* adaptive debounce bounds in scan ticks, */
+    UCHAR_T debounce_max_num;                               /* 0 - fixed debounce time */
+    UINT_T press_min;                                       /* min press time of a click (ms) */
+    BOOL_T short_early;                                     /* SHORT_PRESS on press, may be retracted */
+} KEY_PLAN_T;
+
+/* Key chord */
+typedef struct {
+    CONST KEY_CHORD_DEF_T *chord_def;
+    UINT_T key_mask;            /* bit n - key id n */
+    UINT_T start_time;          /* key time base when the chord became complete (ms) */
+    BOOL_T complete;
+    BOOL_T fired;
+} KEY_CHORD_T;
+
+/* Key bank scan, one bit per pin of the gpio bank or per key of the key source */
+typedef struct {
+    CONST KEY_SRC_T *src;       /* NULL - gpio bank */
+    UINT_T key_mask;            /* bits used by registered keys */
+    UINT_T inv_mask;            /* pins of active low keys */
+    UINT_T soft_mask;           /* keys with their own debounce algorithm */
+    UINT_T soft_busy;           /* keys whose own debounce is settling or whose transition is open */
+    UINT_T key_id_mask;         /* key ids of the bank, bit n - key id n */
+    UINT_T cnt0;                /* vertical counter bit 0 */
+    UINT_T cnt1;                /* vertical counter bit 1 */
+    UINT_T state;               /* debounced state, 1 - pressed */
+} KEY_BANK_T;
+
+/* Key event record */
+typedef struct {
+    UCHAR_T key_id;
+    KEY_PRESS_TYPE_E type;
+    UCHAR_T level;
+    UINT_T duration;            /* hold time of the key (ms) */
+    UINT_T time;                /* clock time when the event was detected */
+} KEY_EVENT_REC_T;
 
 /***********************************************************
 ***********************variable define**********************
 ***********************************************************/
-STATIC KEY_MANAGE_T *sg_key_mag_list = NULL;
+/* key registry, indexed by key id */
+STATIC CONST KEY_DEF_T *sg_key_def_tab[KEY_MAX_NUM] = {NULL};
+STATIC KEY_STATUS_T sg_key_stat_tab[KEY_MAX_NUM] = {0};
+STATIC KEY_PLAN_T sg_key_plan_tab[KEY_MAX_NUM] = {0};
+STATIC KEY_BOUNCE_STAT_T sg_key_bounce_tab[KEY_MAX_NUM] = {0};
+STATIC UCHAR_T sg_key_num = 0;
+STATIC UINT_T sg_key_used_mask = 0;            /* registered keys, bit n - key id n */
+STATIC UCHAR_T sg_key_gen_tab[KEY_MAX_NUM] = {0};   /* handle generation, changed when the key is unregistered */
+STATIC UINT_T sg_key_click_pending = 0;        /* keys with an open click window, bit n - key id n */
+STATIC UINT_T sg_key_press_mask = 0;           /* pressed keys, bit n - key id n */
+STATIC UINT_T sg_key_suppress_mask = 0;        /* keys whose events are taken by a chord */
+STATIC UINT_T sg_key_chord_hold_mask = 0;      /* keys of suppressing chords, SHORT_PRESS waits for the release */
+STATIC KEY_CHORD_T sg_key_chord_tab[KEY_CHORD_MAX_NUM] = {0};
+STATIC UCHAR_T sg_key_chord_num = 0;
+STATIC UCHAR_T sg_key_bit_map[KEY_BANK_NUM][KEY_BANK_BIT_NUM] = {0};   /* key id of each bank bit */
+STATIC KEY_BANK_T sg_key_bank[KEY_BANK_NUM] = {0};
+STATIC BOOL_T sg_key_src_poll = FALSE;          /* a key source without wakeup is registered */
+STATIC KEY_SCAN_MODE_E sg_key_scan_mode = KEY_SCAN_MODE_POLL;
+STATIC BOOL_T sg_key_scan_running = FALSE;
+STATIC volatile BOOL_T sg_key_wakeup_req = FALSE;
+STATIC volatile BOOL_T sg_key_cfg_lock = FALSE; /* a key is being changed, the scan tick is skipped */
+STATIC KEY_SCAN_STAT_T sg_key_scan_stat = {0};
+/* key time base, advanced from clock time differences while scanning */
+STATIC UINT_T sg_key_time_ms = 0;
+STATIC UINT_T sg_key_time_us_rem = 0;
+STATIC UINT_T sg_key_tick_clock = 0;
+/* key event queue, single producer (scan tick) and single consumer (key loop) */
+STATIC volatile KEY_EVENT_REC_T sg_key_evt_queue[KEY_EVENT_QUEUE_SIZE];
+STATIC volatile UCHAR_T sg_key_evt_head = 0;   /* written by the producer only */
+STATIC volatile UCHAR_T sg_key_evt_tail = 0;   /* written by the consumer only */
 
 /***********************************************************
 ***********************function define**********************
@@ -51,233 +160,1546 @@ STATIC INT_T __key_timeout_handler(VOID_T);
  * @brief key gpio init
  * @param[in] pin: pin number
  * @param[in] active_low: TRUE - active low, FALSE - active high
- * @return none
+ * @return KEY_RET
  */
-STATIC VOID_T __key_gpio_init(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T active_low)
+STATIC KEY_RET __key_gpio_init(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T active_low)
 {
-    tuya_gpio_init(port, TRUE, active_low);
+    if (GPIO_OK != tuya_gpio_init(port, TRUE, active_low)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    return KEY_OK;
 }
 
 /**
- * @brief key register
+ * @brief get the scan bank of the key
  * @param[in] key_def: user key define
- * @return KEY_RET
+ * @param[in] alloc: TRUE - allocate a bank for a new key source
+ * @return bank index, KEY_BANK_NUM - no bank
  */
-KEY_RET tuya_reg_key(IN KEY_DEF_T *key_def)
+STATIC UCHAR_T __key_bank_get(IN CONST KEY_DEF_T *key_def, IN CONST BOOL_T alloc)
 {
-    /* check callback function */
-    if (key_def->key_cb == NULL) {
-        return KEY_ERR_CB_UNDEFINED;
+    UCHAR_T bank;
+
+    if (NULL == key_def->src) {
+        return TY_GPIO_PORT_TO_BANK(key_def->port);
+    }
+    for (bank = TY_GPIO_BANK_MAX; bank < KEY_BANK_NUM; bank++) {
+        if (sg_key_bank[bank].src == key_def->src) {
+            return bank;
+        }
+    }
+    if (!alloc) {
+        return KEY_BANK_NUM;
+    }
+    for (bank = TY_GPIO_BANK_MAX; bank < KEY_BANK_NUM; bank++) {
+        if (NULL == sg_key_bank[bank].src) {
+            sg_key_bank[bank].src = key_def->src;
+            return bank;
+        }
+    }
+    return KEY_BANK_NUM;
+}
+
+/**
+ * @brief get the bank bit of the key
+ * @param[in] key_def: user key define
+ * @return bit number
+ */
+STATIC UCHAR_T __key_bank_bit(IN CONST KEY_DEF_T *key_def)
+{
+    return (NULL == key_def->src) ? TY_GPIO_PORT_TO_BIT(key_def->port) : key_def->src_bit;
+}
+
+/**
+ * @brief get the registered key that uses the pin or source key
+ * @param[in] key_def: user key define
+ * @return key id, KEY_ID_NONE - not used
+ */
+STATIC UCHAR_T __key_used_id(IN CONST KEY_DEF_T *key_def)
+{
+    UCHAR_T bank = __key_bank_get(key_def, FALSE);
+    UCHAR_T bit = __key_bank_bit(key_def);
+
+    if ((bank < KEY_BANK_NUM) && (sg_key_bank[bank].key_mask & (1u << bit))) {
+        return sg_key_bit_map[bank][bit];
     }
+    return KEY_ID_NONE;
+}
 
-    /* allocate and clear for key_mag */
-    KEY_MANAGE_T *key_mag = (KEY_MANAGE_T *)tuya_ble_malloc(SIZEOF(KEY_MANAGE_T));
-    if (NULL == key_mag) {
-        return KEY_ERR_MALLOC_FAILED;
+/**
+ * @brief do two key defines refer to the same pin or source key
+ * @param[in] key_def1: user key define
+ * @param[in] key_def2: user key define
+ * @return TRUE or FALSE
+ */
+STATIC BOOL_T __is_key_same(IN CONST KEY_DEF_T *key_def1, IN CONST KEY_DEF_T *key_def2)
+{
+    if (key_def1->src != key_def2->src) {
+        return FALSE;
     }
+    if (NULL == key_def1->src) {
+        return (key_def1->port == key_def2->port);
+    }
+    return (key_def1->src_bit == key_def2->src_bit);
+}
 
-    /* update key manage list */
-    key_mag->key_def_s = key_def;
-    if (sg_key_mag_list) {
-    	key_mag->next = sg_key_mag_list;
-    } else {
-        tuya_software_timer_create(KEY_SCAN_CYCLE_MS*1000, __key_timeout_handler);
+/**
+ * @brief add key to its bank scan
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_bank_add(IN CONST UCHAR_T key_id)
+{
+    CONST KEY_DEF_T *key_def = sg_key_def_tab[key_id];
+    UCHAR_T bank = __key_bank_get(key_def, TRUE);
+    UCHAR_T bit = __key_bank_bit(key_def);
+    KEY_BANK_T *bank_s = &sg_key_bank[bank];
+
+    sg_key_bit_map[bank][bit] = key_id;
+    if ((NULL == key_def->src) && key_def->active_low) {
+        bank_s->inv_mask |= (1u << bit);
     }
-    sg_key_mag_list = key_mag;
+    if (key_def->debounce != KEY_DEBOUNCE_DEFAULT) {
+        bank_s->soft_mask |= (1u << bit);
+    }
+    bank_s->key_mask |= (1u << bit);
+    bank_s->key_id_mask |= (1u << key_id);
+}
 
-    /* gpio init */
-    __key_gpio_init(key_def->port, key_def->active_low);
+/**
+ * @brief remove key from its bank scan, the bank of a key source is freed with its last key
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_bank_del(IN CONST UCHAR_T key_id)
+{
+    CONST KEY_DEF_T *key_def = sg_key_def_tab[key_id];
+    UCHAR_T bank = __key_bank_get(key_def, FALSE);
+    UINT_T mask = ~(1u << __key_bank_bit(key_def));
+    KEY_BANK_T *bank_s = &sg_key_bank[bank];
 
-    return KEY_OK;
+    bank_s->key_mask &= mask;
+    bank_s->inv_mask &= mask;
+    bank_s->soft_mask &= mask;
+    bank_s->soft_busy &= mask;
+    bank_s->cnt0 &= mask;
+    bank_s->cnt1 &= mask;
+    bank_s->state &= mask;
+    bank_s->key_id_mask &= ~(1u << key_id);
+    if ((bank_s->src != NULL) && (0 == bank_s->key_mask)) {
+        bank_s->src = NULL;
+    }
 }
 
 /**
- * @brief key reset
+ * @brief update the polled key source flag from the key source banks
  * @param[in] none
- * @return KEY_RET
+ * @return none
  */
-KEY_RET tuya_key_reset(VOID_T)
+STATIC VOID_T __key_src_poll_update(VOID_T)
 {
-    KEY_MANAGE_T *key_mag_tmp = sg_key_mag_list;
-    if (NULL == key_mag_tmp) {
-        return KEY_ERR_CB_UNDEFINED;
+    UCHAR_T bank;
+
+    sg_key_src_poll = FALSE;
+    for (bank = TY_GPIO_BANK_MAX; bank < KEY_BANK_NUM; bank++) {
+        if ((sg_key_bank[bank].src != NULL) && !sg_key_bank[bank].src->wakeup) {
+            sg_key_src_poll = TRUE;
+        }
     }
-    while (key_mag_tmp) {
-        __key_gpio_init(key_mag_tmp->key_def_s->port, key_mag_tmp->key_def_s->active_low);
-        key_mag_tmp = key_mag_tmp->next;
+}
+
+/**
+ * @brief request a key scan, called by a key source on a key edge, safe in interrupt context
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_wakeup(VOID_T)
+{
+    sg_key_wakeup_req = TRUE;
+    sg_key_scan_stat.wakeup_cnt++;
+}
+
+/**
+ * @brief key edge interrupt callback, only requests a scan
+ * @param[in] port: key port
+ * @return none
+ */
+STATIC VOID_T __key_irq_cb(TY_GPIO_PORT_E port)
+{
+    tuya_key_wakeup();
+}
+
+/**
+ * @brief key edge interrupt init
+ * @param[in] port: key port
+ * @param[in] active_low: TRUE - active low, FALSE - active high
+ * @return KEY_RET
+ */
+STATIC KEY_RET __key_irq_init(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T active_low)
+{
+    TY_GPIO_IRQ_TYPE_E trig_type;
+
+    /* only the press edge is needed, release is detected by scanning */
+    trig_type = active_low ? TY_GPIO_IRQ_FALLING : TY_GPIO_IRQ_RISING;
+    if (GPIO_OK != tuya_gpio_irq_init(port, trig_type, __key_irq_cb)) {
+        return KEY_ERR_INVALID_PARM;
     }
-    tuya_software_timer_delete(__key_timeout_handler);
-    tuya_software_timer_create(KEY_SCAN_CYCLE_MS*1000, __key_timeout_handler);
     return KEY_OK;
 }
 
 /**
- * @brief get the real-time status of the key
- * @param[in] port: key port
- * @param[in] active_low: TURE - active low, FALSE - active high
- * @return key_stat: TRUE - press, FALSE - release
+ * @brief key edge interrupt deinit of the gpio keys of a table
+ * @param[in] key_tab: user key define table
+ * @param[in] key_num: number of keys in the table
+ * @return none
+ */
+STATIC VOID_T __key_irq_deinit(IN CONST KEY_DEF_T *key_tab, IN CONST UCHAR_T key_num)
+{
+    UCHAR_T i;
+
+    if (sg_key_scan_mode != KEY_SCAN_MODE_EDGE) {
+        return;
+    }
+    for (i = 0; i < key_num; i++) {
+        if (NULL == key_tab[i].src) {
+            tuya_gpio_irq_deinit(key_tab[i].port);
+        }
+    }
+}
+
+/**
+ * @brief key scan start
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __key_scan_start(VOID_T)
+{
+    if (sg_key_scan_running) {
+        return;
+    }
+    if (TIMER_OK == tuya_software_timer_create(KEY_SCAN_CYCLE_MS*1000, __key_timeout_handler)) {
+        sg_key_scan_running = TRUE;
+        /* the time base only runs while scanning, no key is held before the start */
+        sg_key_tick_clock = tuya_get_clock_time();
+        sg_key_time_us_rem = 0;
+    }
+}
+
+/**
+ * @brief push key event into the queue, called by the scan tick only
+ * @param[in] key_id: key id
+ * @param[in] type: key event type
+ * @return none
  */
-STATIC BOOL_T __get_key_stat(IN CONST TY_GPIO_PORT_E port, IN CONST UCHAR_T active_low)
+STATIC VOID_T __key_event_push(IN CONST UCHAR_T key_id, IN CONST KEY_PRESS_TYPE_E type)
 {
-    BOOL_T key_stat;
-    if (active_low) {
-        key_stat = tuya_gpio_read(port) == 0 ? TRUE : FALSE;
+    UCHAR_T head = sg_key_evt_head;
+    UCHAR_T depth = (UCHAR_T)(head - sg_key_evt_tail);
+    volatile KEY_EVENT_REC_T *rec = &sg_key_evt_queue[head & KEY_EVENT_QUEUE_MASK];
+
+    if (!(key_id & KEY_CHORD_ID_FLAG)) {
+        /* the key is part of a complete chord, KEY_UP still pairs its KEY_DOWN */
+        if ((sg_key_suppress_mask & (1u << key_id)) && (type != KEY_UP)) {
+            return;
+        }
+        /* KEY_DOWN, KEY_UP and KEY_LEVEL_CROSSED only go to the event callback */
+        if ((type >= KEY_DOWN) && (NULL == sg_key_def_tab[key_id]->evt_cb)) {
+            return;
+        }
+    }
+    if (depth >= KEY_EVENT_QUEUE_SIZE) {
+        sg_key_scan_stat.evt_overflow_cnt++;
+        return;
+    }
+    rec->key_id = key_id;
+    rec->type = type;
+    if (key_id & KEY_CHORD_ID_FLAG) {
+        rec->level = 0;
+        rec->duration = 0;
     } else {
-        key_stat = tuya_gpio_read(port) == 0 ? FALSE : TRUE;
+        rec->level = (sg_key_stat_tab[key_id].level_idx > sg_key_plan_tab[key_id].level_base) ?
+                     (sg_key_stat_tab[key_id].level_idx - sg_key_plan_tab[key_id].level_base) : 0;
+        rec->duration = sg_key_stat_tab[key_id].hold_time;
+    }
+    rec->time = tuya_get_clock_time();
+    /* publish the record after it has been written */
+    sg_key_evt_head = head + 1;
+    depth++;
+    if (depth > sg_key_scan_stat.evt_depth_max) {
+        sg_key_scan_stat.evt_depth_max = depth;
+    }
+}
+
+/**
+ * @brief pop key events from the queue and execute the callback functions
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __key_event_dispatch(VOID_T)
+{
+    KEY_EVENT_REC_T rec;
+    KEY_EVENT_T evt;
+    UCHAR_T tail = sg_key_evt_tail;
+
+    while (tail != sg_key_evt_head) {
+        rec = sg_key_evt_queue[tail & KEY_EVENT_QUEUE_MASK];
+        /* release the slot before the callback, which may take long */
+        tail++;
+        sg_key_evt_tail = tail;
+        if (KEY_ID_NONE == rec.key_id) {
+            continue;
+        }
+        if (rec.key_id & KEY_CHORD_ID_FLAG) {
+            sg_key_chord_tab[rec.key_id & ~KEY_CHORD_ID_FLAG].chord_def->chord_cb(rec.type);
+        } else if (sg_key_def_tab[rec.key_id]->evt_cb != NULL) {
+            evt.type = rec.type;
+            evt.level = rec.level;
+            evt.duration = rec.duration;
+            evt.time = rec.time;
+            sg_key_def_tab[rec.key_id]->evt_cb(&evt);
+        } else {
+            sg_key_def_tab[rec.key_id]->key_cb(rec.type);
+        }
+    }
+}
+
+/**
+ * @brief key set scan mode, must be called before the first key is registered
+ * @param[in] mode: KEY_SCAN_MODE_POLL or KEY_SCAN_MODE_EDGE
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_set_scan_mode(IN CONST KEY_SCAN_MODE_E mode)
+{
+    if (mode > KEY_SCAN_MODE_EDGE) {
+        return KEY_ERR_INVALID_PARM;
     }
-    return key_stat;
+    if (sg_key_num) {
+        return KEY_ERR_INVALID_STATE;
+    }
+    sg_key_scan_mode = mode;
+    return KEY_OK;
+}
+
+/**
+ * @brief convert a debounce time to scan ticks
+ * @param[in] time_ms: debounce time (ms)
+ * @return scan ticks, at least 1
+ */
+STATIC UCHAR_T __key_debounce_ticks(IN CONST UINT_T time_ms)
+{
+    UINT_T num = (time_ms + KEY_SCAN_CYCLE_MS - 1) / KEY_SCAN_CYCLE_MS;
+
+    return (num > 0) ? (UCHAR_T)num : 1;
 }
 
 /**
- * @brief update key status
- * @param[inout] key_mag: key manage information
+ * @brief compute the key decision plan
+ * @param[in] key_def: user key define
+ * @param[out] key_plan: key decision plan
  * @return none
  */
-STATIC VOID_T __update_key_status(INOUT KEY_MANAGE_T *key_mag)
-{
-    BOOL_T key_stat;
-    /* save previous status */
-    key_mag->key_status_s.prv_stat = key_mag->key_status_s.cur_stat;
-    key_mag->key_status_s.prv_time = key_mag->key_status_s.cur_time;
-    /* get the real-time status */
-    key_stat = __get_key_stat(key_mag->key_def_s->port, key_mag->key_def_s->active_low);
-	/* update current status */
-    if (key_stat != key_mag->key_status_s.cur_stat) {
-        key_mag->key_status_s.cur_stat = key_stat;
-        key_mag->key_status_s.cur_time = 0;
+STATIC VOID_T __key_plan_init(IN CONST KEY_DEF_T *key_def, OUT KEY_PLAN_T *key_plan)
+{
+    UINT_T time1 = key_def->long_press_time1;
+    UINT_T time2 = key_def->long_press_time2;
+    KEY_PRESS_TYPE_E type1 = LONG_PRESS_FOR_TIME1;
+    KEY_PRESS_TYPE_E type2 = LONG_PRESS_FOR_TIME2;
+    UCHAR_T i;
+
+    /* multi-click */
+    key_plan->click_max = (key_def->click_max > 1) ? key_def->click_max : 1;
+    key_plan->click_gap = (key_def->click_gap != 0) ? key_def->click_gap : KEY_CLICK_GAP_DEFAULT;
+
+    /* auto-repeat, no acceleration unless the min interval is shorter */
+    key_plan->repeat_delay = (key_def->repeat_delay != 0) ? key_def->repeat_delay : KEY_TIME_NEVER;
+    key_plan->repeat_intv = key_def->repeat_intv;
+    key_plan->repeat_intv_min = ((key_def->repeat_intv_min != 0) && (key_def->repeat_intv_min < key_def->repeat_intv)) ?
+                                key_def->repeat_intv_min : key_def->repeat_intv;
+
+    /* debounce, the own debounce also filters short presses */
+    key_plan->debounce = key_def->debounce;
+    key_plan->debounce_min_num = 0;
+    key_plan->debounce_max_num = 0;
+    if (KEY_DEBOUNCE_DEFAULT == key_def->debounce) {
+        key_plan->debounce_num = KEY_DEBOUNCE_CNT;
+        key_plan->press_min = KEY_PRESS_SHORT_TIME;
     } else {
-        key_mag->key_status_s.cur_time += KEY_SCAN_CYCLE_MS;
+        key_plan->debounce_num = __key_debounce_ticks(key_def->debounce_ms);
+        key_plan->press_min = 0;
+        if (key_def->debounce_max_ms != 0) {
+            /* adaptive: start from debounce_ms within the bounds */
+            key_plan->debounce_min_num = __key_debounce_ticks(key_def->debounce_min_ms);
+            key_plan->debounce_max_num = __key_debounce_ticks(key_def->debounce_max_ms);
+            if (key_plan->debounce_num < key_plan->debounce_min_num) {
+                key_plan->debounce_num = key_plan->debounce_min_num;
+            }
+            if (key_plan->debounce_num > key_plan->debounce_max_num) {
+                key_plan->debounce_num = key_plan->debounce_max_num;
+            }
+        }
+    }
+
+    /* long press table: level n fires LONG_PRESS_FOR_LEVEL(n) */
+    key_plan->level_base = 0;
+    key_plan->short_early = key_def->short_press_early;
+    if (key_def->long_press_num > 0) {
+        key_plan->level_time = key_def->long_press_tab;
+        key_plan->level_num = key_def->long_press_num;
+        for (i = 0; i < key_plan->level_num; i++) {
+            key_plan->level_type[i] = LONG_PRESS_FOR_LEVEL(i);
+        }
+        return;
+    }
+
+    /* two-level define, a special case of the table */
+    key_plan->level_time = key_plan->legacy_time;
+    key_plan->level_num = 0;
+    key_plan->short_early = key_def->short_press_early;
+    if ((0 == time1) && (0 == time2)) {
+        /* no long press, multi-click: clicks are counted on release,
+           auto-repeat: a press is short if it is released before the first repeat */
+        if ((key_plan->click_max > 1) || (key_plan->repeat_delay != KEY_TIME_NEVER)) {
+            return;
+        }
+        /* no long press: short press fires while pressed at the min press time, as on release, nothing to retract */
+        key_plan->short_early = FALSE;
+        key_plan->legacy_time[0] = key_plan->press_min;
+        key_plan->level_type[0] = SHORT_PRESS;
+        key_plan->level_num = 1;
+        key_plan->level_base = 1;
+        return;
     }
+    /* sort the thresholds, the event type follows its time */
+    if (time1 > time2) {
+        time1 = key_def->long_press_time2;
+        time2 = key_def->long_press_time1;
+        type1 = LONG_PRESS_FOR_TIME2;
+        type2 = LONG_PRESS_FOR_TIME1;
+    }
+    if (time1 != 0) {
+        key_plan->legacy_time[key_plan->level_num] = time1;
+        key_plan->level_type[key_plan->level_num] = type1;
+        key_plan->level_num++;
+    }
+    key_plan->legacy_time[key_plan->level_num] = time2;
+    key_plan->level_type[key_plan->level_num] = type2;
+    key_plan->level_num++;
 }
 
 /**
- * @brief is key press over time
- * @param[in] key_status_s: key status
- * @param[in] over_time: over time used for judgment
- * @return TRUE or FALSE
+ * @brief check long press table of the key
+ * @param[in] key_def: user key define
+ * @return KEY_RET
  */
-STATIC BOOL_T __is_key_press_over_time(IN CONST KEY_STATUS_T key_status_s, IN CONST UINT_T over_time)
+STATIC KEY_RET __key_long_press_tab_check(IN CONST KEY_DEF_T *key_def)
 {
-    if (key_status_s.cur_stat == TRUE) {
-        if ((key_status_s.cur_time >= over_time) &&
-            (key_status_s.prv_time < over_time)) {
-            return TRUE;
+    UCHAR_T i;
+
+    if (0 == key_def->long_press_num) {
+        return KEY_OK;
+    }
+    if ((NULL == key_def->long_press_tab) || (key_def->long_press_num > KEY_LONG_PRESS_LEVEL_MAX)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    /* non-zero and in ascending order */
+    if (0 == key_def->long_press_tab[0]) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    for (i = 1; i < key_def->long_press_num; i++) {
+        if (key_def->long_press_tab[i] < key_def->long_press_tab[i - 1]) {
+            return KEY_ERR_INVALID_PARM;
         }
     }
-    return FALSE;
+    return KEY_OK;
 }
 
 /**
- * @brief is key from release to release over time and less time
- * @param[in] key_status_s: key status
- * @param[in] over_time: over time used for judgment
- * @param[in] less_time: less time used for judgment
- * @return TRUE or FALSE
+ * @brief check key table before registering it
+ * @param[in] key_tab: user key define table
+ * @param[in] key_num: number of keys in the table
+ * @param[in] skip_id: registered key being replaced, its pin or source key may be reused, KEY_ID_NONE - none
+ * @return KEY_RET
  */
-STATIC BOOL_T __is_key_release_to_release_over_time_and_less_time(IN CONST KEY_STATUS_T key_status_s, IN CONST UINT_T over_time, IN CONST UINT_T less_time)
+STATIC KEY_RET __key_table_check(IN CONST KEY_DEF_T *key_tab, IN CONST UCHAR_T key_num, IN CONST UCHAR_T skip_id)
 {
-    if ((key_status_s.prv_stat == TRUE) &&
-        (key_status_s.cur_stat == FALSE)) {
-        if ((key_status_s.prv_time >= over_time) &&
-            (key_status_s.prv_time < less_time)) {
-            return TRUE;
+    UCHAR_T i, j, bank, used_id;
+    UCHAR_T src_new = 0, src_free = 0;
+    TY_GPIO_PIN_T pin;
+
+    if ((NULL == key_tab) || (0 == key_num)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    for (i = 0; i < key_num; i++) {
+        /* check callback function */
+        if ((key_tab[i].key_cb == NULL) && (key_tab[i].evt_cb == NULL)) {
+            return KEY_ERR_CB_UNDEFINED;
+        }
+        /* check port or source key, one key per pin, the pin must exist on the chip */
+        if (NULL == key_tab[i].src) {
+            if (GPIO_OK != tuya_gpio_pin_get(key_tab[i].port, &pin)) {
+                return KEY_ERR_INVALID_PARM;
+            }
+        } else {
+            if ((NULL == key_tab[i].src->read) || (key_tab[i].src_bit >= KEY_SRC_KEY_MAX)) {
+                return KEY_ERR_INVALID_PARM;
+            }
+        }
+        used_id = __key_used_id(&key_tab[i]);
+        if ((used_id != KEY_ID_NONE) && (used_id != skip_id)) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        for (j = 0; j < i; j++) {
+            if (__is_key_same(&key_tab[j], &key_tab[i])) {
+                return KEY_ERR_INVALID_PARM;
+            }
+        }
+        /* count the key sources that need a new bank */
+        if ((key_tab[i].src != NULL) && (KEY_BANK_NUM == __key_bank_get(&key_tab[i], FALSE))) {
+            for (j = 0; j < i; j++) {
+                if (key_tab[j].src == key_tab[i].src) {
+                    break;
+                }
+            }
+            if (j == i) {
+                src_new++;
+            }
+        }
+        if (KEY_OK != __key_long_press_tab_check(&key_tab[i])) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        if ((key_tab[i].click_max > KEY_CLICK_MAX) || (key_tab[i].short_press_early && (key_tab[i].click_max > 1))) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        if ((key_tab[i].repeat_delay != 0) && ((key_tab[i].repeat_intv < KEY_SCAN_CYCLE_MS) ||
+            ((key_tab[i].repeat_intv_min != 0) && (key_tab[i].repeat_intv_min < KEY_SCAN_CYCLE_MS)))) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        if ((key_tab[i].debounce > KEY_DEBOUNCE_LOCKOUT) || (key_tab[i].debounce_ms > KEY_DEBOUNCE_TIME_MAX)) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        if ((key_tab[i].debounce_max_ms != 0) &&
+            ((KEY_DEBOUNCE_DEFAULT == key_tab[i].debounce) || (key_tab[i].debounce_max_ms > KEY_DEBOUNCE_TIME_MAX) ||
+             (key_tab[i].debounce_min_ms > key_tab[i].debounce_max_ms))) {
+            return KEY_ERR_INVALID_PARM;
         }
     }
-    return FALSE;
+    for (bank = TY_GPIO_BANK_MAX; bank < KEY_BANK_NUM; bank++) {
+        if (NULL == sg_key_bank[bank].src) {
+            src_free++;
+        }
+    }
+    /* the bank of the replaced key's source is freed with it when it is its only key */
+    if ((skip_id != KEY_ID_NONE) && (sg_key_def_tab[skip_id]->src != NULL)) {
+        bank = __key_bank_get(sg_key_def_tab[skip_id], FALSE);
+        if (sg_key_bank[bank].key_id_mask == (1u << skip_id)) {
+            src_free++;
+        }
+    }
+    if (src_new > src_free) {
+        return KEY_ERR_NO_RESOURCE;
+    }
+    return KEY_OK;
 }
 
 /**
- * @brief detect and handle key event
- * @param[inout] key_mag: key manage information
+ * @brief init the plan and status of a key added to the registry
+ * @param[in] key_id: key id
  * @return none
  */
-STATIC VOID_T __detect_and_handle_key_event(INOUT KEY_MANAGE_T *key_mag)
+STATIC VOID_T __key_status_init(IN CONST UCHAR_T key_id)
 {
-    KEY_PRESS_TYPE_E type;
-    BOOL_T time_exchange;
-    UINT_T long_time1, long_time2;
-
-    /* compare long_time1 and long time2 */
-    if (key_mag->key_def_s->long_press_time2 >= key_mag->key_def_s->long_press_time1) {
-        long_time1 = key_mag->key_def_s->long_press_time1;
-        long_time2 = key_mag->key_def_s->long_press_time2;
-        time_exchange = FALSE;
-    } else {
-        long_time1 = key_mag->key_def_s->long_press_time2;
-        long_time2 = key_mag->key_def_s->long_press_time1;
-        time_exchange = TRUE;
-    }
-    /* judge key status */
-    if ((long_time2 != 0) && (long_time1 != 0)) {
-        if (__is_key_press_over_time(key_mag->key_status_s, long_time2)) {
-            type = LONG_PRESS_FOR_TIME2;
-            goto KEY_EVENT;
-        }
-        if (__is_key_release_to_release_over_time_and_less_time(key_mag->key_status_s, long_time1, long_time2)) {
-            type = LONG_PRESS_FOR_TIME1;
-            goto KEY_EVENT;
-        }
-        if (__is_key_release_to_release_over_time_and_less_time(key_mag->key_status_s, KEY_PRESS_SHORT_TIME, long_time1)){
-            type = SHORT_PRESS;
-            goto KEY_EVENT;
-        }
-    } else if ((long_time2 != 0) && (long_time1 == 0)) {
-        if (__is_key_press_over_time(key_mag->key_status_s, long_time2)) {
-            type = LONG_PRESS_FOR_TIME2;
-            goto KEY_EVENT;
-        }
-        if (__is_key_release_to_release_over_time_and_less_time(key_mag->key_status_s, KEY_PRESS_SHORT_TIME, long_time2)){
-            type = SHORT_PRESS;
-            goto KEY_EVENT;
-        }
-    } else if ((long_time2 == 0) && (long_time1 != 0)) {
-        if (__is_key_press_over_time(key_mag->key_status_s, long_time1)) {
-            type = LONG_PRESS_FOR_TIME1;
-            goto KEY_EVENT;
-        }
-        if (__is_key_release_to_release_over_time_and_less_time(key_mag->key_status_s, KEY_PRESS_SHORT_TIME, long_time1)){
-            type = SHORT_PRESS;
-            goto KEY_EVENT;
+    __key_plan_init(sg_key_def_tab[key_id], &sg_key_plan_tab[key_id]);
+    sg_key_stat_tab[key_id].cur_stat = FALSE;
+    sg_key_stat_tab[key_id].level_idx = 0;
+    sg_key_stat_tab[key_id].hold_time = 0;
+    sg_key_stat_tab[key_id].next_time = KEY_TIME_NEVER;
+    sg_key_stat_tab[key_id].click_cnt = 0;
+    sg_key_stat_tab[key_id].repeated = FALSE;
+    sg_key_stat_tab[key_id].db_hist = 0;
+    sg_key_stat_tab[key_id].db_cnt = 0;
+    sg_key_stat_tab[key_id].db_raw = FALSE;
+    sg_key_stat_tab[key_id].bounce_edges = 0;
+    sg_key_stat_tab[key_id].bounce_avg = 0;
+    sg_key_bounce_tab[key_id].edge_cnt_last = 0;
+    sg_key_bounce_tab[key_id].edge_cnt_max = 0;
+    sg_key_bounce_tab[key_id].span_last = 0;
+    sg_key_bounce_tab[key_id].span_max = 0;
+}
+
+/**
+ * @brief key table register, the table is referenced and must stay valid
+ * @param[in] key_tab: user key define table
+ * @param[in] key_num: number of keys in the table
+ * @return KEY_RET
+ */
+KEY_RET tuya_reg_key_table(IN CONST KEY_DEF_T *key_tab, IN CONST UCHAR_T key_num)
+{
+    UCHAR_T i, key_id;
+    KEY_RET ret;
+
+    if ((NULL != key_tab) && (key_num > (KEY_MAX_NUM - sg_key_num))) {
+        return KEY_ERR_NO_RESOURCE;
+    }
+    ret = __key_table_check(key_tab, key_num, KEY_ID_NONE);
+    if (KEY_OK != ret) {
+        return ret;
+    }
+
+    /* gpio init of all keys first, nothing is registered if one fails */
+    for (i = 0; i < key_num; i++) {
+        if (key_tab[i].src != NULL) {
+            /* the key source owns its pins */
+            continue;
+        }
+        ret = __key_gpio_init(key_tab[i].port, key_tab[i].active_low);
+        if ((KEY_OK == ret) && (sg_key_scan_mode == KEY_SCAN_MODE_EDGE)) {
+            ret = __key_irq_init(key_tab[i].port, key_tab[i].active_low);
+        }
+        if (KEY_OK != ret) {
+            __key_irq_deinit(key_tab, i);
+            return ret;
         }
+    }
+
+    for (i = 0; i < key_num; i++) {
+        if ((key_tab[i].src != NULL) && !key_tab[i].src->wakeup) {
+            sg_key_src_poll = TRUE;
+        }
+        /* add to key registry, the first free key id */
+        key_id = __builtin_ctz(~sg_key_used_mask);
+        sg_key_def_tab[key_id] = &key_tab[i];
+        __key_status_init(key_id);
+        __key_bank_add(key_id);
+        sg_key_used_mask |= (1u << key_id);
+        sg_key_num++;
+    }
+
+    /* edge mode: scan once to pick up a key that is already pressed */
+    if (sg_key_scan_mode == KEY_SCAN_MODE_EDGE) {
+        sg_key_wakeup_req = TRUE;
     } else {
-        if (__is_key_press_over_time(key_mag->key_status_s, KEY_PRESS_SHORT_TIME)) {
-            type = SHORT_PRESS;
-            goto KEY_EVENT;
-        }
-    }
-    return;
-    /* handle key event */
-KEY_EVENT:
-    /* if the time parameter has been exchanged before the judgment */
-    if (time_exchange) {
-        /* exchanged the event type  */
-        if (type == LONG_PRESS_FOR_TIME2) {
-            type = LONG_PRESS_FOR_TIME1;
-        } else if (type == LONG_PRESS_FOR_TIME1) {
-            type = LONG_PRESS_FOR_TIME2;
-        } else {
-            ;
+        __key_scan_start();
+    }
+
+    return KEY_OK;
+}
+
+/**
+ * @brief key register
+ * @param[in] key_def: user key define
+ * @return KEY_RET
+ */
+KEY_RET tuya_reg_key(IN KEY_DEF_T *key_def)
+{
+    return tuya_reg_key_table(key_def, 1);
+}
+
+/**
+ * @brief get key id of a registered key define
+ * @param[in] key_def: user key define
+ * @param[out] key_id: key id
+ * @return KEY_RET
+ */
+STATIC KEY_RET __key_id_get(IN CONST KEY_DEF_T *key_def, OUT UCHAR_T *key_id)
+{
+    UINT_T used = sg_key_used_mask;
+    UCHAR_T i;
+
+    while (used) {
+        i = __builtin_ctz(used);
+        used &= used - 1;
+        if (sg_key_def_tab[i] == key_def) {
+            *key_id = i;
+            return KEY_OK;
         }
     }
-    /* execute the callback function */
-    key_mag->key_def_s->key_cb(type);
+    return KEY_ERR_INVALID_PARM;
 }
 
 /**
- * @brief key timeout handler
- * @param[in] none
+ * @brief get key id of a key handle
+ * @param[in] handle: key handle
+ * @param[out] key_id: key id
+ * @return KEY_RET
+ */
+STATIC KEY_RET __key_handle_get(IN CONST KEY_HANDLE handle, OUT UCHAR_T *key_id)
+{
+    UINT_T i = handle & KEY_HANDLE_ID_MASK;
+
+    /* a handle of an unregistered key has an old generation */
+    if ((i >= KEY_MAX_NUM) || !(sg_key_used_mask & (1u << i)) || ((handle >> 8) != sg_key_gen_tab[i])) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    *key_id = (UCHAR_T)i;
+    return KEY_OK;
+}
+
+/**
+ * @brief get the handle of a registered key
+ * @param[in] key_def: registered key define
+ * @param[out] handle: key handle
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_get_handle(IN CONST KEY_DEF_T *key_def, OUT KEY_HANDLE *handle)
+{
+    UCHAR_T key_id;
+
+    if ((NULL == handle) || (KEY_OK != __key_id_get(key_def, &key_id))) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    *handle = ((KEY_HANDLE)sg_key_gen_tab[key_id] << 8) | key_id;
+    return KEY_OK;
+}
+
+/**
+ * @brief drop the queued events of the key, called with the scan tick locked
+ * @param[in] key_id: key id
  * @return none
  */
-STATIC INT_T __key_timeout_handler(VOID_T)
+STATIC VOID_T __key_event_drop(IN CONST UCHAR_T key_id)
 {
-    KEY_MANAGE_T *key_mag_tmp = sg_key_mag_list;
-    if (NULL == key_mag_tmp) {
-        return 0;
+    UCHAR_T tail;
+
+    /* the records between tail and head belong to the consumer */
+    for (tail = sg_key_evt_tail; tail != sg_key_evt_head; tail++) {
+        if (sg_key_evt_queue[tail & KEY_EVENT_QUEUE_MASK].key_id == key_id) {
+            sg_key_evt_queue[tail & KEY_EVENT_QUEUE_MASK].key_id = KEY_ID_NONE;
+        }
+    }
+}
+
+/**
+ * @brief detach the key from the scan, called with the scan tick locked,
+ *        the edge interrupt of its pin is left to the caller
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_detach(IN CONST UCHAR_T key_id)
+{
+    UINT_T mask = ~(1u << key_id);
+
+    __key_bank_del(key_id);
+    __key_src_poll_update();
+    __key_event_drop(key_id);
+    sg_key_click_pending &= mask;
+    sg_key_press_mask &= mask;
+    sg_key_suppress_mask &= mask;
+}
+
+/**
+ * @brief is the key part of a chord
+ * @param[in] key_id: key id
+ * @return TRUE or FALSE
+ */
+STATIC BOOL_T __is_key_in_chord(IN CONST UCHAR_T key_id)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < sg_key_chord_num; i++) {
+        if (sg_key_chord_tab[i].key_mask & (1u << key_id)) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * @brief key unregister, the other keys keep their status,
+ *        a key of a chord cannot be unregistered
+ * @param[in] handle: key handle
+ * @return KEY_RET
+ */
+KEY_RET tuya_unreg_key(IN CONST KEY_HANDLE handle)
+{
+    UCHAR_T key_id;
+
+    if (KEY_OK != __key_handle_get(handle, &key_id)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    if (__is_key_in_chord(key_id)) {
+        return KEY_ERR_INVALID_STATE;
+    }
+
+    sg_key_cfg_lock = TRUE;
+    __key_detach(key_id);
+    __key_irq_deinit(sg_key_def_tab[key_id], 1);
+    sg_key_def_tab[key_id] = NULL;
+    sg_key_used_mask &= ~(1u << key_id);
+    sg_key_gen_tab[key_id]++;
+    sg_key_num--;
+    sg_key_cfg_lock = FALSE;
+    return KEY_OK;
+}
+
+/**
+ * @brief key update, replaces the define of a registered key, the other keys keep their status,
+ *        events of the old define still queued are dropped and a held key is seen as a new press,
+ *        on an error the old define is kept
+ * @param[in] handle: key handle, stays valid
+ * @param[in] key_def: new user key define, referenced and must stay valid
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_update(IN CONST KEY_HANDLE handle, IN CONST KEY_DEF_T *key_def)
+{
+    UCHAR_T key_id;
+    CONST KEY_DEF_T *old_def;
+    BOOL_T same_pin;
+    KEY_RET ret;
+
+    if (KEY_OK != __key_handle_get(handle, &key_id)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    ret = __key_table_check(key_def, 1, key_id);
+    if (KEY_OK != ret) {
+        return ret;
+    }
+    old_def = sg_key_def_tab[key_id];
+    same_pin = (NULL == old_def->src) && (NULL == key_def->src) && (old_def->port == key_def->port);
+
+    sg_key_cfg_lock = TRUE;
+    /* set up the new pin while the old key is still attached, so a failure leaves it as it was */
+    if (NULL == key_def->src) {
+        ret = __key_gpio_init(key_def->port, key_def->active_low);
+        if ((KEY_OK == ret) && (sg_key_scan_mode == KEY_SCAN_MODE_EDGE)) {
+            ret = __key_irq_init(key_def->port, key_def->active_low);
+        }
+        if (KEY_OK != ret) {
+            if (same_pin) {
+                __key_gpio_init(old_def->port, old_def->active_low);
+                if (sg_key_scan_mode == KEY_SCAN_MODE_EDGE) {
+                    __key_irq_init(old_def->port, old_def->active_low);
+                }
+            } else {
+                __key_irq_deinit(key_def, 1);
+            }
+            sg_key_cfg_lock = FALSE;
+            return ret;
+        }
+    }
+    __key_detach(key_id);
+    if (!same_pin) {
+        __key_irq_deinit(old_def, 1);
+    }
+    sg_key_def_tab[key_id] = key_def;
+    __key_status_init(key_id);
+    __key_bank_add(key_id);
+    __key_src_poll_update();
+    sg_key_cfg_lock = FALSE;
+
+    /* edge mode: scan once to pick up a key that is already pressed */
+    if (sg_key_scan_mode == KEY_SCAN_MODE_EDGE) {
+        sg_key_wakeup_req = TRUE;
+    }
+    return ret;
+}
+
+/**
+ * @brief key chord register, its keys must be registered first and the define is referenced
+ * @param[in] chord_def: user chord define
+ * @return KEY_RET
+ */
+KEY_RET tuya_reg_key_chord(IN CONST KEY_CHORD_DEF_T *chord_def)
+{
+    UCHAR_T i, key_id;
+    UINT_T key_mask = 0;
+
+    if (NULL == chord_def) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    if (NULL == chord_def->chord_cb) {
+        return KEY_ERR_CB_UNDEFINED;
+    }
+    if (sg_key_chord_num >= KEY_CHORD_MAX_NUM) {
+        return KEY_ERR_NO_RESOURCE;
+    }
+    /* resolve the keys into a key id mask once */
+    for (i = 0; i < KEY_CHORD_KEY_MAX; i++) {
+        if (NULL == chord_def->keys[i]) {
+            continue;
+        }
+        if (KEY_OK != __key_id_get(chord_def->keys[i], &key_id)) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        key_mask |= (1u << key_id);
+    }
+    /* a chord needs at least two keys */
+    if ((key_mask & (key_mask - 1)) == 0) {
+        return KEY_ERR_INVALID_PARM;
+    }
+
+    sg_key_chord_tab[sg_key_chord_num].chord_def = chord_def;
+    sg_key_chord_tab[sg_key_chord_num].key_mask = key_mask;
+    sg_key_chord_tab[sg_key_chord_num].complete = FALSE;
+    sg_key_chord_tab[sg_key_chord_num].fired = FALSE;
+    sg_key_chord_num++;
+    if (chord_def->suppress) {
+        sg_key_chord_hold_mask |= key_mask;
+    }
+    return KEY_OK;
+}
+
+/**
+ * @brief key reset
+ * @param[in] none
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_reset(VOID_T)
+{
+    UINT_T used = sg_key_used_mask;
+    UCHAR_T key_id;
+
+    if (0 == sg_key_num) {
+        return KEY_ERR_CB_UNDEFINED;
+    }
+    while (used) {
+        key_id = __builtin_ctz(used);
+        used &= used - 1;
+        if (NULL == sg_key_def_tab[key_id]->src) {
+            __key_gpio_init(sg_key_def_tab[key_id]->port, sg_key_def_tab[key_id]->active_low);
+        }
+    }
+    if (sg_key_scan_running) {
+        tuya_software_timer_delete(__key_timeout_handler);
+        sg_key_scan_running = FALSE;
+    }
+    if (sg_key_scan_mode == KEY_SCAN_MODE_EDGE) {
+        sg_key_wakeup_req = TRUE;
+    } else {
+        __key_scan_start();
+    }
+    return KEY_OK;
+}
+
+/**
+ * @brief key loop, must be called in the main loop, executes the key callbacks
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_loop(VOID_T)
+{
+    __key_event_dispatch();
+    if (sg_key_wakeup_req) {
+        __key_scan_start();
+    }
+}
+
+/**
+ * @brief get key scan statistics
+ * @param[out] stat: scan statistics
+ * @return none
+ */
+VOID_T tuya_key_get_scan_stat(OUT KEY_SCAN_STAT_T *stat)
+{
+    *stat = sg_key_scan_stat;
+}
+
+/**
+ * @brief clear key scan statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_clr_scan_stat(VOID_T)
+{
+    sg_key_scan_stat.scan_cnt = 0;
+    sg_key_scan_stat.wakeup_cnt = 0;
+    sg_key_scan_stat.evt_overflow_cnt = 0;
+    sg_key_scan_stat.evt_depth_max = 0;
+    sg_key_scan_stat.tick_cost_last = 0;
+    sg_key_scan_stat.tick_cost_max = 0;
+    sg_key_scan_stat.bank_skip_cnt = 0;
+    sg_key_scan_stat.tick_drift_last = 0;
+    sg_key_scan_stat.tick_drift_max = 0;
+    sg_key_scan_stat.click_delay_last = 0;
+    sg_key_scan_stat.click_delay_max = 0;
+    sg_key_scan_stat.early_gain_last = 0;
+    sg_key_scan_stat.early_gain_max = 0;
+    sg_key_scan_stat.retract_cnt = 0;
+}
+
+/**
+ * @brief get bounce statistics of a key with a non-default debounce algorithm
+ * @param[in] key_def: registered key define
+ * @param[out] stat: bounce statistics
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_get_bounce_stat(IN CONST KEY_DEF_T *key_def, OUT KEY_BOUNCE_STAT_T *stat)
+{
+    UCHAR_T key_id;
+
+    if ((NULL == stat) || (KEY_OK != __key_id_get(key_def, &key_id))) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    *stat = sg_key_bounce_tab[key_id];
+    stat->debounce_ms = sg_key_plan_tab[key_id].debounce_num * KEY_SCAN_CYCLE_MS;
+    return KEY_OK;
+}
+
+/**
+ * @brief resolve the multi-click gesture of the key
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_click_resolve(IN CONST UCHAR_T key_id)
+{
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+
+    if (0 == key_status->click_cnt) {
+        return;
+    }
+    if (1 == key_status->click_cnt) {
+        __key_event_push(key_id, SHORT_PRESS);
+    } else {
+        __key_event_push(key_id, DOUBLE_CLICK + key_status->click_cnt - 2);
+    }
+    key_status->click_cnt = 0;
+    sg_key_click_pending &= ~(1u << key_id);
+
+    /* latency added by waiting for the click window */
+    sg_key_scan_stat.click_delay_last = sg_key_time_ms - key_status->release_time;
+    if (sg_key_scan_stat.click_delay_last > sg_key_scan_stat.click_delay_max) {
+        sg_key_scan_stat.click_delay_max = sg_key_scan_stat.click_delay_last;
+    }
+}
+
+/**
+ * @brief handle a click (short press) of the key
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_click(IN CONST UCHAR_T key_id)
+{
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+    UCHAR_T click_max = sg_key_plan_tab[key_id].click_max;
+
+    /* single click only: no added latency */
+    if (click_max <= 1) {
+        __key_event_push(key_id, SHORT_PRESS);
+        return;
+    }
+    key_status->click_cnt++;
+    if (key_status->click_cnt >= click_max) {
+        /* nothing more to wait for */
+        __key_click_resolve(key_id);
+    } else {
+        sg_key_click_pending |= (1u << key_id);
+    }
+}
+
+/**
+ * @brief close the click windows that timed out
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __key_click_window_check(VOID_T)
+{
+    UINT_T pending = sg_key_click_pending;
+    UCHAR_T key_id;
+
+    while (pending) {
+        key_id = __builtin_ctz(pending);
+        pending &= pending - 1;
+        if (!sg_key_stat_tab[key_id].cur_stat &&
+            ((sg_key_time_ms - sg_key_stat_tab[key_id].release_time) >= sg_key_plan_tab[key_id].click_gap)) {
+            __key_click_resolve(key_id);
+        }
+    }
+}
+
+/**
+ * @brief send the SHORT_PRESS of the key on press, once the min press time is reached
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_short_early(IN CONST UCHAR_T key_id)
+{
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+
+    if (!sg_key_plan_tab[key_id].short_early || key_status->early_fired || (key_status->level_idx > 0) ||
+        key_status->repeated || (key_status->hold_time < sg_key_plan_tab[key_id].press_min) ||
+        (sg_key_suppress_mask & (1u << key_id))) {
+        return;
+    }
+    /* once per press, level_idx and repeated only grow while held */
+    key_status->early_fired = TRUE;
+    key_status->early_time = key_status->hold_time;
+    __key_event_push(key_id, SHORT_PRESS);
+}
+
+/**
+ * @brief retract the SHORT_PRESS sent on press, the press became something else
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_short_retract(IN CONST UCHAR_T key_id)
+{
+    if (!sg_key_stat_tab[key_id].early_fired) {
+        return;
+    }
+    sg_key_stat_tab[key_id].early_fired = FALSE;
+    sg_key_scan_stat.retract_cnt++;
+    __key_event_push(key_id, SHORT_PRESS_RETRACT);
+}
+
+/**
+ * @brief the press with a SHORT_PRESS sent on press is released, record the time gained
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_short_early_gain(IN CONST UCHAR_T key_id)
+{
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+
+    sg_key_scan_stat.early_gain_last = key_status->hold_time - key_status->early_time;
+    if (sg_key_scan_stat.early_gain_last > sg_key_scan_stat.early_gain_max) {
+        sg_key_scan_stat.early_gain_max = sg_key_scan_stat.early_gain_last;
+    }
+}
+
+/**
+ * @brief auto-repeat of the held key, driven by the scan tick
+ * @param[in] key_id: key id
+ * @return none
+ */
+STATIC VOID_T __key_repeat_check(IN CONST UCHAR_T key_id)
+{
+    CONST KEY_PLAN_T *key_plan = &sg_key_plan_tab[key_id];
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+
+    if (key_status->hold_time < key_status->repeat_time) {
+        return;
+    }
+    /* a repeating key gives no click on release */
+    if (!key_status->repeated) {
+        key_status->repeated = TRUE;
+        __key_click_resolve(key_id);
+        __key_short_retract(key_id);
+    }
+    __key_event_push(key_id, HOLD_REPEAT);
+    /* a late tick sends one event, never a burst */
+    key_status->repeat_time = key_status->hold_time + key_status->repeat_intv;
+    if (key_status->repeat_intv > key_plan->repeat_intv_min) {
+        key_status->repeat_intv -= (key_status->repeat_intv >> KEY_REPEAT_ACCEL_SHIFT);
+        if (key_status->repeat_intv < key_plan->repeat_intv_min) {
+            key_status->repeat_intv = key_plan->repeat_intv_min;
+        }
+    }
+}
+
+/**
+ * @brief update key status and detect key event
+ * @param[in] key_id: key id
+ * @param[in] key_stat: debounced status, TRUE - press, FALSE - release
+ * @return none
+ */
+STATIC VOID_T __update_key_status(IN CONST UCHAR_T key_id, IN CONST BOOL_T key_stat)
+{
+    CONST KEY_PLAN_T *key_plan = &sg_key_plan_tab[key_id];
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+
+    if (key_stat) {
+        if (!key_status->cur_stat) {
+            /* pressed: restart the plan */
+            key_status->cur_stat = TRUE;
+            sg_key_press_mask |= (1u << key_id);
+            sg_key_suppress_mask &= ~(1u << key_id);
+            key_status->press_time = sg_key_time_ms;
+            key_status->level_idx = 0;
+            key_status->next_time = (key_plan->level_num > 0) ? key_plan->level_time[0] : KEY_TIME_NEVER;
+            if (key_plan->level_base && (sg_key_chord_hold_mask & (1u << key_id))) {
+                /* the chord may still complete, SHORT_PRESS is sent on release unless suppressed */
+                key_status->next_time = KEY_TIME_NEVER;
+            }
+            key_status->repeated = FALSE;
+            key_status->repeat_time = key_plan->repeat_delay;
+            key_status->repeat_intv = key_plan->repeat_intv;
+            key_status->hold_time = 0;
+            key_status->early_fired = FALSE;
+            __key_event_push(key_id, KEY_DOWN);
+        }
+        key_status->hold_time = sg_key_time_ms - key_status->press_time;
+        /* the only per-tick check while holding */
+        while (key_status->hold_time >= key_status->next_time) {
+            /* a long press ends the click sequence */
+            __key_click_resolve(key_id);
+            __key_short_retract(key_id);
+            key_status->level_idx++;
+            if (key_plan->level_type[key_status->level_idx - 1] != SHORT_PRESS) {
+                __key_event_push(key_id, KEY_LEVEL_CROSSED);
+            }
+            if (key_status->level_idx < key_plan->level_num) {
+                key_status->next_time = key_plan->level_time[key_status->level_idx];
+            } else {
+                /* the last threshold fires while the key is still pressed */
+                key_status->next_time = KEY_TIME_NEVER;
+                __key_event_push(key_id, key_plan->level_type[key_plan->level_num - 1]);
+            }
+        }
+        /* a held press is no click, it ends the sequence */
+        if (key_status->click_cnt && (key_status->hold_time >= KEY_CLICK_PRESS_MAX)) {
+            __key_click_resolve(key_id);
+        }
+        __key_short_early(key_id);
+        __key_repeat_check(key_id);
+    } else {
+        /* released: the highest threshold reached decides the event */
+        key_status->cur_stat = FALSE;
+        sg_key_press_mask &= ~(1u << key_id);
+        key_status->release_time = sg_key_time_ms;
+        key_status->hold_time = key_status->release_time - key_status->press_time;
+        __key_event_push(key_id, KEY_UP);
+        if (sg_key_suppress_mask & (1u << key_id)) {
+            return;
+        }
+        if ((key_plan->level_num > 0) && (key_status->level_idx >= key_plan->level_num)) {
+            return;
+        }
+        if (key_status->level_idx > 0) {
+            __key_event_push(key_id, key_plan->level_type[key_status->level_idx - 1]);
+        } else if (key_status->early_fired) {
+            __key_short_early_gain(key_id);
+        } else if ((key_status->hold_time >= key_plan->press_min) && !key_status->repeated &&
+                   ((key_plan->click_max <= 1) || (key_status->hold_time < KEY_CLICK_PRESS_MAX))) {
+            __key_click(key_id);
+        } else {
+            ;
+        }
+    }
+}
+
+/**
+ * @brief detect chord events, one mask compare per chord
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __key_chord_check(VOID_T)
+{
+    UCHAR_T i, key_id;
+    UINT_T key_mask;
+    KEY_CHORD_T *chord;
+
+    for (i = 0; i < sg_key_chord_num; i++) {
+        chord = &sg_key_chord_tab[i];
+        if ((sg_key_press_mask & chord->key_mask) != chord->key_mask) {
+            chord->complete = FALSE;
+            chord->fired = FALSE;
+            continue;
+        }
+        if (!chord->complete) {
+            chord->complete = TRUE;
+            chord->start_time = sg_key_time_ms;
+            if (chord->chord_def->suppress) {
+                /* the keys pressed first may have sent their SHORT_PRESS already */
+                key_mask = chord->key_mask;
+                while (key_mask) {
+                    key_id = __builtin_ctz(key_mask);
+                    key_mask &= key_mask - 1;
+                    __key_short_retract(key_id);
+                }
+                sg_key_suppress_mask |= chord->key_mask;
+            }
+        }
+        if (!chord->fired && ((sg_key_time_ms - chord->start_time) >= chord->chord_def->hold_time)) {
+            chord->fired = TRUE;
+            __key_event_push(KEY_CHORD_ID_FLAG | i, CHORD_PRESS);
+        }
+    }
+}
+
+/**
+ * @brief debounce all keys of a bank at once with 2-bit vertical counters
+ * @param[inout] bank_s: bank scan information
+ * @param[in] sample: pressed bits sampled in this tick
+ * @return bits whose debounced state toggled in this tick
+ */
+STATIC UINT_T __key_bank_debounce(INOUT KEY_BANK_T *bank_s, IN CONST UINT_T sample)
+{
+    UINT_T delta, toggle;
+
+    /* count the ticks each bit differs from its debounced state, reset where equal */
+    delta = (sample ^ bank_s->state) & ~bank_s->soft_mask;
+    toggle = delta & bank_s->cnt0 & bank_s->cnt1;
+    bank_s->cnt1 = (bank_s->cnt1 ^ bank_s->cnt0) & delta;
+    bank_s->cnt0 = ~bank_s->cnt0 & delta;
+    /* toggle after KEY_DEBOUNCE_CNT consecutive different samples */
+    bank_s->state ^= toggle;
+    return toggle;
+}
+
+/**
+ * @brief debounce a key with its own algorithm
+ * @param[in] key_id: key id
+ * @param[in] sample: TRUE - pressed in this tick
+ * @param[in] state: debounced state, TRUE - pressed
+ * @param[out] settling: TRUE - the debounce needs more ticks
+ * @return new debounced state
+ */
+STATIC BOOL_T __key_debounce(IN CONST UCHAR_T key_id, IN CONST BOOL_T sample, IN CONST BOOL_T state, OUT BOOL_T *settling)
+{
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+    UCHAR_T num = sg_key_plan_tab[key_id].debounce_num;
+    BOOL_T new_state = state;
+    UINT_T mask, hist;
+
+    switch (sg_key_plan_tab[key_id].debounce) {
+    case KEY_DEBOUNCE_INTEGRATOR:
+        if (sample && (key_status->db_cnt < num)) {
+            key_status->db_cnt++;
+        } else if (!sample && (key_status->db_cnt > 0)) {
+            key_status->db_cnt--;
+        } else {
+            ;
+        }
+        if (key_status->db_cnt == num) {
+            new_state = TRUE;
+        } else if (0 == key_status->db_cnt) {
+            new_state = FALSE;
+        } else {
+            ;
+        }
+        *settling = (key_status->db_cnt != (new_state ? num : 0));
+        break;
+    case KEY_DEBOUNCE_SHIFT:
+        mask = (num >= 32) ? 0xFFFFFFFF : ((1u << num) - 1);
+        key_status->db_hist = (key_status->db_hist << 1) | (sample ? 1 : 0);
+        hist = key_status->db_hist & mask;
+        if (hist == mask) {
+            new_state = TRUE;
+        } else if (0 == hist) {
+            new_state = FALSE;
+        } else {
+            ;
+        }
+        *settling = (hist != (new_state ? mask : 0));
+        break;
+    case KEY_DEBOUNCE_LOCKOUT:
+        if (key_status->db_cnt > 0) {
+            key_status->db_cnt--;
+        } else if (sample != state) {
+            new_state = sample;
+            key_status->db_cnt = num;
+        } else {
+            ;
+        }
+        *settling = (key_status->db_cnt > 0);
+        break;
+    default:
+        new_state = sample;
+        *settling = FALSE;
+        break;
+    }
+    return new_state;
+}
+
+/**
+ * @brief record the raw edges of the transition being debounced and adapt the debounce time
+ * @param[in] key_id: key id
+ * @param[in] sample: TRUE - pressed in this tick
+ * @param[in] settling: TRUE - the debounce needs more ticks
+ * @return none
+ */
+STATIC VOID_T __key_bounce_update(IN CONST UCHAR_T key_id, IN CONST BOOL_T sample, IN CONST BOOL_T settling)
+{
+    KEY_STATUS_T *key_status = &sg_key_stat_tab[key_id];
+    KEY_PLAN_T *key_plan = &sg_key_plan_tab[key_id];
+    KEY_BOUNCE_STAT_T *bounce = &sg_key_bounce_tab[key_id];
+    UINT_T span, num;
+
+    if (sample != key_status->db_raw) {
+        key_status->db_raw = sample;
+        if (0 == key_status->bounce_edges) {
+            key_status->bounce_first = sg_key_time_ms;
+        }
+        key_status->bounce_last = sg_key_time_ms;
+        if (key_status->bounce_edges < 0xFF) {
+            key_status->bounce_edges++;
+        }
+    }
+    if (settling || (0 == key_status->bounce_edges)) {
+        return;
+    }
+    /* transition settled: no raw edge for the current debounce time, as the debounce sees it */
+    if ((sg_key_time_ms - key_status->bounce_last) < (key_plan->debounce_num * KEY_SCAN_CYCLE_MS)) {
+        return;
+    }
+
+    span = key_status->bounce_last - key_status->bounce_first;
+    bounce->edge_cnt_last = key_status->bounce_edges;
+    bounce->span_last = span;
+    if (bounce->edge_cnt_last > bounce->edge_cnt_max) {
+        bounce->edge_cnt_max = bounce->edge_cnt_last;
+    }
+    if (span > bounce->span_max) {
+        bounce->span_max = span;
+    }
+    key_status->bounce_edges = 0;
+    if (0 == key_plan->debounce_max_num) {
+        return;
+    }
+
+    /* adaptive: the debounce window covers the average span plus one tick */
+    span = (span << KEY_BOUNCE_AVG_Q) / KEY_SCAN_CYCLE_MS;
+    if (span >= key_status->bounce_avg) {
+        key_status->bounce_avg += (span - key_status->bounce_avg) >> KEY_BOUNCE_AVG_SHIFT;
+    } else {
+        key_status->bounce_avg -= (key_status->bounce_avg - span) >> KEY_BOUNCE_AVG_SHIFT;
+    }
+    num = ((key_status->bounce_avg + (1u << KEY_BOUNCE_AVG_Q) - 1) >> KEY_BOUNCE_AVG_Q) + 1;
+    if (num < key_plan->debounce_min_num) {
+        num = key_plan->debounce_min_num;
+    }
+    if (num > key_plan->debounce_max_num) {
+        num = key_plan->debounce_max_num;
+    }
+    key_plan->debounce_num = (UCHAR_T)num;
+    /* the integrator rests at its limits */
+    if ((KEY_DEBOUNCE_INTEGRATOR == key_plan->debounce) && (key_status->db_cnt != 0)) {
+        key_status->db_cnt = key_plan->debounce_num;
+    }
+}
+
+/**
+ * @brief debounce the keys of a bank that have their own algorithm
+ * @param[in] bank: bank index
+ * @param[inout] bank_s: bank scan information
+ * @param[in] sample: pressed bits sampled in this tick
+ * @return bits whose debounced state toggled in this tick
+ */
+STATIC UINT_T __key_bank_soft_debounce(IN CONST UCHAR_T bank, INOUT KEY_BANK_T *bank_s, IN CONST UINT_T sample)
+{
+    UINT_T soft = bank_s->soft_mask;
+    UINT_T toggle = 0;
+    UCHAR_T bit, key_id;
+    BOOL_T state, sample_bit, settling;
+
+    bank_s->soft_busy = 0;
+    while (soft) {
+        bit = __builtin_ctz(soft);
+        soft &= soft - 1;
+        key_id = sg_key_bit_map[bank][bit];
+        state = (bank_s->state >> bit) & 0x01;
+        sample_bit = (sample >> bit) & 0x01;
+        if (__key_debounce(key_id, sample_bit, state, &settling) != state) {
+            toggle |= (1u << bit);
+        }
+        __key_bounce_update(key_id, sample_bit, settling);
+        /* an open transition needs the ticks of its quiet window, also in edge mode */
+        if (settling || (sg_key_stat_tab[key_id].bounce_edges != 0)) {
+            bank_s->soft_busy |= (1u << bit);
+        }
+    }
+    bank_s->state ^= toggle;
+    return toggle;
+}
+
+/**
+ * @brief advance the key time base by the real time since the last tick
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __key_time_update(VOID_T)
+{
+    UINT_T now = tuya_get_clock_time();
+    UINT_T elapsed_us, elapsed_ms;
+
+    elapsed_us = tuya_get_clock_time_diff_us(sg_key_tick_clock, now) + sg_key_time_us_rem;
+    elapsed_ms = elapsed_us / 1000;
+    sg_key_time_us_rem = elapsed_us % 1000;
+    sg_key_tick_clock = now;
+    sg_key_time_ms += elapsed_ms;
+
+    /* timer starvation, e.g. delayed by radio events */
+    sg_key_scan_stat.tick_drift_last = (elapsed_ms > KEY_SCAN_CYCLE_MS) ? (elapsed_ms - KEY_SCAN_CYCLE_MS) : 0;
+    if (sg_key_scan_stat.tick_drift_last > sg_key_scan_stat.tick_drift_max) {
+        sg_key_scan_stat.tick_drift_max = sg_key_scan_stat.tick_drift_last;
+    }
+}
+
+/**
+ * @brief update the worst-case scan tick cost
+ * @param[in] tick_start: clock time when the tick started
+ * @return none
+ */
+STATIC VOID_T __key_tick_cost_update(IN CONST UINT_T tick_start)
+{
+    sg_key_scan_stat.tick_cost_last = tuya_get_clock_time() - tick_start;
+    if (sg_key_scan_stat.tick_cost_last > sg_key_scan_stat.tick_cost_max) {
+        sg_key_scan_stat.tick_cost_max = sg_key_scan_stat.tick_cost_last;
+    }
+}
+
+/**
+ * @brief is the bank idle: no key pressed, settling or waiting for another click
+ * @param[in] bank_s: bank scan information
+ * @return TRUE or FALSE
+ */
+STATIC BOOL_T __is_key_bank_idle(IN CONST KEY_BANK_T *bank_s)
+{
+    if (bank_s->state | bank_s->cnt0 | bank_s->cnt1 | bank_s->soft_busy) {
+        return FALSE;
+    }
+    return (0 == (sg_key_click_pending & bank_s->key_id_mask));
+}
+
+/**
+ * @brief key timeout handler
+ * @param[in] none
+ * @return 0 - keep the timer, -1 - remove the timer (edge mode, all keys settled)
+ */
+STATIC INT_T __key_timeout_handler(VOID_T)
+{
+    UCHAR_T bank;
+    KEY_BANK_T *bank_s;
+    UCHAR_T key_id;
+    UINT_T sample, active, busy = 0;
+    UCHAR_T bit;
+    UINT_T tick_start = tuya_get_clock_time();
+    BOOL_T wakeup = sg_key_wakeup_req;
+
+    sg_key_scan_stat.scan_cnt++;
+    /* a key is being changed: the time base catches up in the next tick */
+    if (sg_key_cfg_lock) {
+        return 0;
+    }
+    __key_time_update();
+    /* clear the request before sampling, an edge after this point keeps the timer */
+    sg_key_wakeup_req = FALSE;
+    for (bank = 0; bank < KEY_BANK_NUM; bank++) {
+        bank_s = &sg_key_bank[bank];
+        if (0 == bank_s->key_mask) {
+            continue;
+        }
+        /* idle banks are sampled every KEY_SCAN_IDLE_DIV ticks, staggered by bank, active ones every tick */
+        if (!wakeup && ((sg_key_scan_stat.scan_cnt + bank) % KEY_SCAN_IDLE_DIV) && __is_key_bank_idle(bank_s)) {
+            sg_key_scan_stat.bank_skip_cnt++;
+            continue;
+        }
+        /* one register read per gpio bank, one read per key source */
+        if (NULL == bank_s->src) {
+            sample = (tuya_gpio_read_bank(bank) ^ bank_s->inv_mask) & bank_s->key_mask;
+        } else {
+            sample = bank_s->src->read() & bank_s->key_mask;
+        }
+        /* only keys that are pressed or have just been released need event handling */
+        active = __key_bank_debounce(bank_s, sample) | bank_s->state;
+        if (bank_s->soft_mask) {
+            active |= __key_bank_soft_debounce(bank, bank_s, sample);
+        }
+        while (active) {
+            bit = __builtin_ctz(active);
+            active &= active - 1;
+            key_id = sg_key_bit_map[bank][bit];
+            __update_key_status(key_id, (bank_s->state >> bit) & 0x01);
+        }
+        busy |= bank_s->state | bank_s->cnt0 | bank_s->cnt1 | bank_s->soft_busy;
     }
-    while (key_mag_tmp) {
-        __update_key_status(key_mag_tmp);
-        __detect_and_handle_key_event(key_mag_tmp);
-        key_mag_tmp = key_mag_tmp->next;
+    __key_chord_check();
+    __key_click_window_check();
+    busy |= sg_key_click_pending;
+    __key_tick_cost_update(tick_start);
+    /* edge mode: stop when all keys are released and no key is settling, polled key sources keep it */
+    if ((sg_key_scan_mode == KEY_SCAN_MODE_EDGE) && (0 == busy) && !sg_key_src_poll && !sg_key_wakeup_req) {
+        sg_key_scan_running = FALSE;
+        return -1;
     }
     return 0;
 }
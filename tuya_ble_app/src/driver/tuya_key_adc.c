@@ -0,0 +1,149 @@
+/**
+ * @file tuya_key_adc.c
+ * @author lifan
+ * @brief adc resistor ladder key driver source file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "tuya_key_adc.h"
+#include "tuya_adc.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_ADC_DIFF(a, b)      (((a) > (b)) ? ((a) - (b)) : ((b) - (a)))
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST KEY_ADC_DEF_T *sg_adc_def = NULL;
+STATIC UINT_T sg_adc_key_state = 0;            /* last sample inside a window */
+STATIC KEY_ADC_STAT_T sg_adc_stat = {0};
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief check the adc ladder define, no two windows may overlap
+ * @param[in] adc_def: user adc ladder define
+ * @return KEY_RET
+ */
+STATIC KEY_RET __adc_def_check(IN CONST KEY_ADC_DEF_T *adc_def)
+{
+    UCHAR_T i, j;
+    UINT_T gap = 2 * adc_def->margin_mv;
+
+    if ((NULL == adc_def->key_mv) || (0 == adc_def->key_num) || (adc_def->key_num > KEY_ADC_KEY_MAX)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    for (i = 0; i < adc_def->key_num; i++) {
+        if (KEY_ADC_DIFF(adc_def->key_mv[i], adc_def->idle_mv) <= gap) {
+            return KEY_ERR_INVALID_PARM;
+        }
+        for (j = 0; j < i; j++) {
+            if (KEY_ADC_DIFF(adc_def->key_mv[i], adc_def->key_mv[j]) <= gap) {
+                return KEY_ERR_INVALID_PARM;
+            }
+        }
+    }
+    return KEY_OK;
+}
+
+/**
+ * @brief adc ladder init, the define is referenced and must stay valid,
+ *        the keys are then registered with a KEY_SRC_T of tuya_key_adc_read(),
+ *        it has no edge interrupt, so the key source is polled (wakeup FALSE)
+ * @param[in] adc_def: user adc ladder define
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_adc_init(IN CONST KEY_ADC_DEF_T *adc_def)
+{
+    if (sg_adc_def != NULL) {
+        return KEY_ERR_INVALID_STATE;
+    }
+    if ((NULL == adc_def) || (KEY_OK != __adc_def_check(adc_def))) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    if (ADC_OK != tuya_adc_init(adc_def->port)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    sg_adc_key_state = 0;
+    sg_adc_def = adc_def;
+    return KEY_OK;
+}
+
+/**
+ * @brief classify the ladder voltage
+ * @param[in] mv: sampled voltage (mV)
+ * @param[out] key_state: key states, bit n - key n, 1 - pressed
+ * @return TRUE - inside a window, FALSE - in the guard band between windows
+ */
+STATIC BOOL_T __adc_classify(IN CONST UINT_T mv, OUT UINT_T *key_state)
+{
+    UCHAR_T i;
+
+    if (KEY_ADC_DIFF(mv, sg_adc_def->idle_mv) <= sg_adc_def->margin_mv) {
+        *key_state = 0;
+        return TRUE;
+    }
+    for (i = 0; i < sg_adc_def->key_num; i++) {
+        if (KEY_ADC_DIFF(mv, sg_adc_def->key_mv[i]) <= sg_adc_def->margin_mv) {
+            *key_state = (1u << i);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * @brief adc ladder read, one sample for all keys, used as the read function of the key source
+ * @param[in] none
+ * @return key states, bit n - key n, 1 - pressed
+ */
+UINT_T tuya_key_adc_read(VOID_T)
+{
+    UINT_T key_state;
+
+    if (NULL == sg_adc_def) {
+        return 0;
+    }
+    sg_adc_stat.mv_last = tuya_adc_read_mv();
+    sg_adc_stat.sample_cnt++;
+    /* the voltage passes other windows while a key moves, keep the last classified state */
+    if (__adc_classify(sg_adc_stat.mv_last, &key_state)) {
+        sg_adc_key_state = key_state;
+    } else {
+        sg_adc_stat.guard_cnt++;
+    }
+    return sg_adc_key_state;
+}
+
+/**
+ * @brief get adc ladder statistics
+ * @param[out] stat: adc ladder statistics
+ * @return none
+ */
+VOID_T tuya_key_adc_get_stat(OUT KEY_ADC_STAT_T *stat)
+{
+    *stat = sg_adc_stat;
+}
+
+/**
+ * @brief clear adc ladder statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_adc_clr_stat(VOID_T)
+{
+    sg_adc_stat.sample_cnt = 0;
+    sg_adc_stat.guard_cnt = 0;
+    sg_adc_stat.mv_last = 0;
+}
@@ -0,0 +1,309 @@
+/**
+ * @file tuya_key_matrix.c
+ * @author lifan
+ * @brief matrix keypad driver source file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "tuya_key_matrix.h"
+#include "tuya_timer.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_MATRIX_SETTLE_US    2       /* column settle time after a row is switched */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST KEY_MATRIX_DEF_T *sg_matrix_def = NULL;
+STATIC TY_GPIO_BANK_E sg_matrix_col_bank = 0;
+STATIC UCHAR_T sg_matrix_col_mask[KEY_MATRIX_COL_MAX] = {0};   /* bank bit of each column */
+STATIC UCHAR_T sg_matrix_row_bank_mask[TY_GPIO_BANK_MAX] = {0}; /* row pins of each bank */
+STATIC TY_GPIO_PIN_T sg_matrix_row_pin[KEY_MATRIX_ROW_MAX];     /* rows written in the sweep without the port checks */
+STATIC UINT_T sg_matrix_key_state = 0;                          /* last sweep without ghost keys */
+STATIC KEY_MATRIX_STAT_T sg_matrix_stat = {0};
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief drive all rows, one register write per bank
+ * @param[in] level: output level, FALSE - all rows selected
+ * @return none
+ */
+STATIC VOID_T __matrix_row_write_all(IN CONST BOOL_T level)
+{
+    TY_GPIO_BANK_E bank;
+
+    for (bank = 0; bank < TY_GPIO_BANK_MAX; bank++) {
+        if (0 == sg_matrix_row_bank_mask[bank]) {
+            continue;
+        }
+        if (level) {
+            tuya_gpio_set_bank(bank, sg_matrix_row_bank_mask[bank]);
+        } else {
+            tuya_gpio_clr_bank(bank, sg_matrix_row_bank_mask[bank]);
+        }
+    }
+}
+
+/**
+ * @brief wait for the column lines to settle
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __matrix_settle(VOID_T)
+{
+    UINT_T start = tuya_get_clock_time();
+
+    while (!tuya_is_clock_time_exceed(start, KEY_MATRIX_SETTLE_US)) {
+        ;
+    }
+}
+
+/**
+ * @brief column interrupt callback, a key of the idle matrix was pressed
+ * @param[in] port: column port
+ * @return none
+ */
+STATIC VOID_T __matrix_col_irq_cb(TY_GPIO_PORT_E port)
+{
+    tuya_key_wakeup();
+}
+
+/**
+ * @brief enable or disable the column interrupts
+ * @param[in] matrix_def: user matrix define
+ * @param[in] enable: TRUE - enable, FALSE - disable
+ * @return none
+ */
+STATIC VOID_T __matrix_col_irq_set(IN CONST KEY_MATRIX_DEF_T *matrix_def, IN CONST BOOL_T enable)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < matrix_def->col_num; i++) {
+        tuya_gpio_irq_set_enable(matrix_def->col_port[i], enable);
+    }
+}
+
+/**
+ * @brief undo a failed matrix init
+ * @param[in] matrix_def: user matrix define
+ * @return none
+ */
+STATIC VOID_T __matrix_deinit(IN CONST KEY_MATRIX_DEF_T *matrix_def)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < matrix_def->col_num; i++) {
+        tuya_gpio_irq_deinit(matrix_def->col_port[i]);
+        sg_matrix_col_mask[i] = 0;
+    }
+    for (i = 0; i < TY_GPIO_BANK_MAX; i++) {
+        sg_matrix_row_bank_mask[i] = 0;
+    }
+}
+
+/**
+ * @brief check the matrix define
+ * @param[in] matrix_def: user matrix define
+ * @return KEY_RET
+ */
+STATIC KEY_RET __matrix_def_check(IN CONST KEY_MATRIX_DEF_T *matrix_def)
+{
+    UCHAR_T i;
+    TY_GPIO_PIN_T pin;
+
+    if ((NULL == matrix_def) || (NULL == matrix_def->row_port) || (NULL == matrix_def->col_port)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    if ((0 == matrix_def->row_num) || (matrix_def->row_num > KEY_MATRIX_ROW_MAX) ||
+        (0 == matrix_def->col_num) || (matrix_def->col_num > KEY_MATRIX_COL_MAX) ||
+        ((matrix_def->row_num * matrix_def->col_num) > KEY_SRC_KEY_MAX)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    /* the pins must exist on the chip */
+    for (i = 0; i < matrix_def->row_num; i++) {
+        if (GPIO_OK != tuya_gpio_pin_get(matrix_def->row_port[i], &pin)) {
+            return KEY_ERR_INVALID_PARM;
+        }
+    }
+    /* all columns are read at once */
+    for (i = 0; i < matrix_def->col_num; i++) {
+        if ((GPIO_OK != tuya_gpio_pin_get(matrix_def->col_port[i], &pin)) ||
+            (TY_GPIO_PORT_TO_BANK(matrix_def->col_port[i]) != TY_GPIO_PORT_TO_BANK(matrix_def->col_port[0]))) {
+            return KEY_ERR_INVALID_PARM;
+        }
+    }
+    return KEY_OK;
+}
+
+/**
+ * @brief matrix keypad init, the define is referenced and must stay valid,
+ *        the keys are then registered with a KEY_SRC_T of tuya_key_matrix_read()
+ * @param[in] matrix_def: user matrix define
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_matrix_init(IN CONST KEY_MATRIX_DEF_T *matrix_def)
+{
+    UCHAR_T i;
+
+    if (sg_matrix_def != NULL) {
+        return KEY_ERR_INVALID_STATE;
+    }
+    if (KEY_OK != __matrix_def_check(matrix_def)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+
+    for (i = 0; i < matrix_def->row_num; i++) {
+        if (GPIO_OK != tuya_gpio_init(matrix_def->row_port[i], FALSE, TRUE)) {
+            __matrix_deinit(matrix_def);
+            return KEY_ERR_INVALID_PARM;
+        }
+        sg_matrix_row_bank_mask[TY_GPIO_PORT_TO_BANK(matrix_def->row_port[i])] |= TY_GPIO_PORT_TO_MASK(matrix_def->row_port[i]);
+        tuya_gpio_pin_get(matrix_def->row_port[i], &sg_matrix_row_pin[i]);
+    }
+    for (i = 0; i < matrix_def->col_num; i++) {
+        /* any press of the idle matrix pulls its column low */
+        if ((GPIO_OK != tuya_gpio_init(matrix_def->col_port[i], TRUE, TRUE)) ||
+            (GPIO_OK != tuya_gpio_irq_init(matrix_def->col_port[i], TY_GPIO_IRQ_FALLING, __matrix_col_irq_cb))) {
+            __matrix_deinit(matrix_def);
+            return KEY_ERR_INVALID_PARM;
+        }
+        sg_matrix_col_mask[i] = 1 << TY_GPIO_PORT_TO_BIT(matrix_def->col_port[i]);
+    }
+    sg_matrix_col_bank = TY_GPIO_PORT_TO_BANK(matrix_def->col_port[0]);
+    sg_matrix_key_state = 0;
+    sg_matrix_def = matrix_def;
+
+    /* idle: all rows selected */
+    __matrix_row_write_all(FALSE);
+    return KEY_OK;
+}
+
+/**
+ * @brief read the columns of the selected rows
+ * @param[in] none
+ * @return pressed columns, bit n - column n
+ */
+STATIC UCHAR_T __matrix_col_read(VOID_T)
+{
+    UCHAR_T level = tuya_gpio_read_bank(sg_matrix_col_bank);
+    UCHAR_T col, col_bits = 0;
+
+    for (col = 0; col < sg_matrix_def->col_num; col++) {
+        if (!(level & sg_matrix_col_mask[col])) {
+            col_bits |= (1 << col);
+        }
+    }
+    return col_bits;
+}
+
+/**
+ * @brief check ghost keys: without diodes, two rows sharing two pressed columns
+ *        show a fourth key that may not be pressed
+ * @param[in] row_bits: pressed columns of each row
+ * @return TRUE - ghost keys possible
+ */
+STATIC BOOL_T __matrix_ghost_check(IN CONST UCHAR_T *row_bits)
+{
+    UCHAR_T i, j, common;
+
+    for (i = 0; i < sg_matrix_def->row_num; i++) {
+        /* a row needs two pressed columns to be a part of the rectangle */
+        if (0 == (row_bits[i] & (row_bits[i] - 1))) {
+            continue;
+        }
+        for (j = i + 1; j < sg_matrix_def->row_num; j++) {
+            common = row_bits[i] & row_bits[j];
+            if (common & (common - 1)) {
+                return TRUE;
+            }
+        }
+    }
+    return FALSE;
+}
+
+/**
+ * @brief matrix keypad read, sweeps all rows, used as the read function of the key source
+ * @param[in] none
+ * @return key states, bit KEY_MATRIX_BIT(row, col, col_num), 1 - pressed
+ */
+UINT_T tuya_key_matrix_read(VOID_T)
+{
+    UCHAR_T row_bits[KEY_MATRIX_ROW_MAX];
+    UCHAR_T row, col_bits = 0;
+    UINT_T key_state = 0;
+    UINT_T sweep_start;
+
+    if (NULL == sg_matrix_def) {
+        return 0;
+    }
+    sweep_start = tuya_get_clock_time();
+    /* the row switching pulls the columns of the pressed keys, these are no new presses */
+    __matrix_col_irq_set(sg_matrix_def, FALSE);
+    __matrix_row_write_all(TRUE);
+    for (row = 0; row < sg_matrix_def->row_num; row++) {
+        tuya_gpio_pin_write(&sg_matrix_row_pin[row], FALSE);
+        __matrix_settle();
+        row_bits[row] = __matrix_col_read();
+        tuya_gpio_pin_write(&sg_matrix_row_pin[row], TRUE);
+        key_state |= ((UINT_T)row_bits[row] << (row * sg_matrix_def->col_num));
+        col_bits |= row_bits[row];
+    }
+    /* back to idle, so a new press raises a column interrupt */
+    __matrix_row_write_all(FALSE);
+    __matrix_settle();
+    __matrix_col_irq_set(sg_matrix_def, TRUE);
+    /* a column pulled after its rows were swept is a new press */
+    if (__matrix_col_read() & ~col_bits) {
+        tuya_key_wakeup();
+    }
+
+    /* keep the last good state, the debounce sees no change, and keep scanning until it is resolved */
+    if (__matrix_ghost_check(row_bits)) {
+        sg_matrix_stat.ghost_cnt++;
+        tuya_key_wakeup();
+    } else {
+        sg_matrix_key_state = key_state;
+    }
+
+    sg_matrix_stat.sweep_cnt++;
+    sg_matrix_stat.sweep_cost_last = tuya_get_clock_time() - sweep_start;
+    if (sg_matrix_stat.sweep_cost_last > sg_matrix_stat.sweep_cost_max) {
+        sg_matrix_stat.sweep_cost_max = sg_matrix_stat.sweep_cost_last;
+    }
+    return sg_matrix_key_state;
+}
+
+/**
+ * @brief get matrix keypad statistics
+ * @param[out] stat: matrix statistics
+ * @return none
+ */
+VOID_T tuya_key_matrix_get_stat(OUT KEY_MATRIX_STAT_T *stat)
+{
+    *stat = sg_matrix_stat;
+}
+
+/**
+ * @brief clear matrix keypad statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_key_matrix_clr_stat(VOID_T)
+{
+    sg_matrix_stat.sweep_cnt = 0;
+    sg_matrix_stat.ghost_cnt = 0;
+    sg_matrix_stat.sweep_cost_last = 0;
+    sg_matrix_stat.sweep_cost_max = 0;
+}
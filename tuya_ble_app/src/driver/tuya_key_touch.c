@@ -0,0 +1,146 @@
+/**
+ * @file tuya_key_touch.c
+ * @author lifan
+ * @brief capacitive touch key driver source file
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "tuya_key_touch.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_TOUCH_BASE_Q        8       /* baseline fraction bits */
+#define KEY_TOUCH_SHIFT_MAX     8       /* the baseline still moves 1 fraction bit for a 1 count difference */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST KEY_TOUCH_DEF_T *sg_touch_def = NULL;
+STATIC UINT_T sg_touch_count[KEY_TOUCH_CH_MAX] = {0};
+STATIC UINT_T sg_touch_baseline[KEY_TOUCH_CH_MAX] = {0};  /* KEY_TOUCH_BASE_Q fraction bits */
+STATIC UINT_T sg_touch_state = 0;                          /* bit n - channel n touched */
+STATIC UCHAR_T sg_touch_base_ch = 0;                       /* next baseline to update */
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief touch keys init, the define is referenced and must stay valid, the baselines start
+ *        from the first counts, the keys are then registered with a KEY_SRC_T of tuya_key_touch_read(),
+ *        the channels are polled (wakeup FALSE)
+ * @param[in] touch_def: user touch define
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_touch_init(IN CONST KEY_TOUCH_DEF_T *touch_def)
+{
+    UCHAR_T ch;
+
+    if (sg_touch_def != NULL) {
+        return KEY_ERR_INVALID_STATE;
+    }
+    if ((NULL == touch_def) || (NULL == touch_def->read)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    if ((0 == touch_def->ch_num) || (touch_def->ch_num > KEY_TOUCH_CH_MAX) ||
+        (touch_def->release_delta >= touch_def->touch_delta) || (touch_def->baseline_shift > KEY_TOUCH_SHIFT_MAX)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+
+    for (ch = 0; ch < touch_def->ch_num; ch++) {
+        sg_touch_count[ch] = touch_def->read(ch);
+        sg_touch_baseline[ch] = sg_touch_count[ch] << KEY_TOUCH_BASE_Q;
+    }
+    sg_touch_state = 0;
+    sg_touch_base_ch = 0;
+    sg_touch_def = touch_def;
+    return KEY_OK;
+}
+
+/**
+ * @brief update the baseline of an untouched channel
+ * @param[in] ch: channel
+ * @return none
+ */
+STATIC VOID_T __touch_baseline_update(IN CONST UCHAR_T ch)
+{
+    UINT_T count_q = sg_touch_count[ch] << KEY_TOUCH_BASE_Q;
+    UCHAR_T shift = sg_touch_def->baseline_shift;
+
+    /* the baseline is frozen while touched */
+    if (sg_touch_state & (1u << ch)) {
+        return;
+    }
+    /* falling counts are followed faster, a channel touched at init is usable soon after the release,
+       a dip held long enough to move the baseline by touch_delta gives a false touch when it ends */
+    if (count_q >= sg_touch_baseline[ch]) {
+        sg_touch_baseline[ch] += (count_q - sg_touch_baseline[ch]) >> shift;
+    } else {
+        sg_touch_baseline[ch] -= (sg_touch_baseline[ch] - count_q) >> (shift >> 1);
+    }
+}
+
+/**
+ * @brief touch keys read, reads all channels and updates some baselines,
+ *        used as the read function of the key source
+ * @param[in] none
+ * @return key states, bit n - channel n, 1 - touched
+ */
+UINT_T tuya_key_touch_read(VOID_T)
+{
+    UCHAR_T ch, i;
+    UINT_T base, delta;
+
+    if (NULL == sg_touch_def) {
+        return 0;
+    }
+    for (ch = 0; ch < sg_touch_def->ch_num; ch++) {
+        sg_touch_count[ch] = sg_touch_def->read(ch);
+        base = sg_touch_baseline[ch] >> KEY_TOUCH_BASE_Q;
+        delta = (sg_touch_count[ch] > base) ? (sg_touch_count[ch] - base) : 0;
+        /* hysteresis between the touch and release thresholds */
+        if (sg_touch_state & (1u << ch)) {
+            if (delta < sg_touch_def->release_delta) {
+                sg_touch_state &= ~(1u << ch);
+            }
+        } else {
+            if (delta >= sg_touch_def->touch_delta) {
+                sg_touch_state |= (1u << ch);
+            }
+        }
+    }
+    /* a few baselines per tick, round robin */
+    for (i = 0; (i < KEY_TOUCH_BASE_UPDATE_NUM) && (i < sg_touch_def->ch_num); i++) {
+        __touch_baseline_update(sg_touch_base_ch);
+        sg_touch_base_ch++;
+        if (sg_touch_base_ch >= sg_touch_def->ch_num) {
+            sg_touch_base_ch = 0;
+        }
+    }
+    return sg_touch_state;
+}
+
+/**
+ * @brief get touch channel information
+ * @param[in] ch: channel
+ * @param[out] info: channel information
+ * @return KEY_RET
+ */
+KEY_RET tuya_key_touch_get_ch_info(IN CONST UCHAR_T ch, OUT KEY_TOUCH_CH_INFO_T *info)
+{
+    if ((NULL == sg_touch_def) || (ch >= sg_touch_def->ch_num) || (NULL == info)) {
+        return KEY_ERR_INVALID_PARM;
+    }
+    info->count = sg_touch_count[ch];
+    info->baseline = sg_touch_baseline[ch] >> KEY_TOUCH_BASE_Q;
+    info->touched = (sg_touch_state >> ch) & 0x01;
+    return KEY_OK;
+}
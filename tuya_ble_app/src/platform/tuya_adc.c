@@ -0,0 +1,59 @@
+/**
+ * @file tuya_adc.c
+ * @author lifan
+ * @brief tuya adc source file for TLSR825x
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "tuya_adc.h"
+#include "gpio_8258.h"
+#include "adc.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+/* TLSR825x pin define of the port: group << 8 | bit mask */
+#define ADC_PORT_TO_PIN(port)   ((GPIO_PinTypeDef)((TY_GPIO_PORT_TO_BANK(port) << 8) | (1 << TY_GPIO_PORT_TO_BIT(port))))
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief tuya adc init, one adc input at a time
+ * @param[in] port: adc input pin, TY_GPIOB_0 ~ TY_GPIOB_7, TY_GPIOC_4 or TY_GPIOC_5
+ * @return ADC_RET
+ */
+ADC_RET tuya_adc_init(IN CONST TY_GPIO_PORT_E port)
+{
+    if ((TY_GPIO_PORT_TO_BANK(port) != TY_GPIO_BANK_B) && (port != TY_GPIOC_4) && (port != TY_GPIOC_5)) {
+        return ADC_ERR_INVALID_PARM;
+    }
+
+    adc_init();
+    adc_base_init(ADC_PORT_TO_PIN(port));
+    adc_power_on_sar_adc(1);
+
+    return ADC_OK;
+}
+
+/**
+ * @brief tuya adc read
+ * @param[in] none
+ * @return input voltage (mV)
+ */
+UINT_T tuya_adc_read_mv(VOID_T)
+{
+    return adc_sample_and_get_result();
+}
@@ -10,21 +10,22 @@
  */
 
 #include "tuya_gpio.h"
-#include "tuya_ble_mem.h"
+#include "tuya_timer.h"
 #include "gpio_8258.h"
 
 /***********************************************************
 ************************micro define************************
 ***********************************************************/
+#define TY_GPIO_EDGE_FIFO_MASK  (TY_GPIO_EDGE_FIFO_SIZE - 1)
+#define TY_GPIO_PIN_NONE        ((GPIO_PinTypeDef)-1)   /* no pin on the chip, see sg_pf_pin_list */
+
+#if (TY_GPIO_EDGE_FIFO_SIZE & TY_GPIO_EDGE_FIFO_MASK) || (TY_GPIO_EDGE_FIFO_SIZE > 128)
+#error "TY_GPIO_EDGE_FIFO_SIZE must be a power of 2 and no more than 128"
+#endif
 
 /***********************************************************
 ***********************typedef define***********************
 ***********************************************************/
-typedef struct ty_gpio_irq_mag_s {
-    struct ty_gpio_irq_mag_s *next;
-    TY_GPIO_PORT_E port;
-    TY_GPIO_IRQ_CB irq_cb;
-} TY_GPIO_IRQ_MAG_T;
 
 /***********************************************************
 ***********************variable define**********************
@@ -64,8 +65,42 @@ STATIC GPIO_PinTypeDef sg_pf_pin_list[] = {
     GPIO_PD7
 };
 
-STATIC TY_GPIO_IRQ_MAG_T *sg_rise_mag_list = NULL;
-STATIC TY_GPIO_IRQ_MAG_T *sg_fall_mag_list = NULL;
+/* pins of each bank in sg_pf_pin_list, bit n - pin n, only these are written by the bank functions,
+   must follow sg_pf_pin_list */
+STATIC CONST UCHAR_T sg_bank_pin_mask[TY_GPIO_BANK_MAX] = {
+    0x03,       /* PA0 PA1 */
+    0xF2,       /* PB1 PB4 PB5 PB6 PB7 */
+    0x1F,       /* PC0 PC1 PC2 PC3 PC4 */
+    0x9C        /* PD2 PD3 PD4 PD7 */
+};
+
+STATIC TY_GPIO_IRQ_CB sg_irq_cb_tab[TY_GPIO_MAX] = {NULL};
+/* interrupt pins of each bank, bit n - pin n */
+STATIC UCHAR_T sg_rise_mask[TY_GPIO_BANK_MAX] = {0};
+STATIC UCHAR_T sg_fall_mask[TY_GPIO_BANK_MAX] = {0};
+STATIC UCHAR_T sg_both_mask[TY_GPIO_BANK_MAX] = {0};
+STATIC UCHAR_T sg_irq_level[TY_GPIO_BANK_MAX] = {0};   /* pin level at the last edge, the polarity waits for the other level */
+STATIC UCHAR_T sg_edge_mask[TY_GPIO_BANK_MAX] = {0};   /* both edge pins queued in the edge fifo */
+STATIC UCHAR_T sg_irq_off_mask[TY_GPIO_BANK_MAX] = {0}; /* interrupt pins disabled by tuya_gpio_irq_set_enable() */
+
+/* edge fifo, single producer (irq) and single consumer */
+STATIC volatile TY_GPIO_EDGE_T sg_edge_fifo[TY_GPIO_EDGE_FIFO_SIZE];
+STATIC volatile UCHAR_T sg_edge_head = 0;      /* written by the irq only */
+STATIC volatile UCHAR_T sg_edge_tail = 0;      /* written by the consumer only */
+STATIC volatile UINT_T sg_edge_lost_cnt = 0;
+
+/* interrupt hold-off, the pins are masked in the gpio irq and enabled again in the timer irq,
+   meanwhile they stay on the plain gpio channel, which is not in reg_irq_mask: its source bit only
+   latches an edge of a masked pin for the timer irq */
+STATIC BOOL_T sg_holdoff_init = FALSE;
+STATIC TY_HW_TIMER_TYPE_E sg_holdoff_timer = TY_TIMER_0;
+STATIC BOOL_T sg_holdoff_running = FALSE;
+STATIC UCHAR_T sg_holdoff_mask[TY_GPIO_BANK_MAX] = {0};    /* pins with hold-off */
+STATIC UCHAR_T sg_holdoff_busy[TY_GPIO_BANK_MAX] = {0};    /* pins masked now */
+STATIC UCHAR_T sg_holdoff_level[TY_GPIO_BANK_MAX] = {0};   /* pin level when masked */
+STATIC UCHAR_T sg_holdoff_pend[TY_GPIO_BANK_MAX] = {0};    /* masked pins with a latched edge */
+STATIC UCHAR_T sg_holdoff_tick[TY_GPIO_MAX] = {0};         /* timer ticks left */
+STATIC volatile TY_GPIO_HOLDOFF_STAT_T sg_holdoff_stat = {0};
 
 /***********************************************************
 ***********************function define**********************
@@ -82,7 +117,7 @@ GPIO_RET tuya_gpio_init(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T in, IN CON
     if (port >= TY_GPIO_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
         return GPIO_ERR_INVALID_PARM;
     }
 
@@ -142,7 +177,7 @@ GPIO_RET tuya_gpio_input_init(IN CONST TY_GPIO_PORT_E port, IN CONST TY_GPIO_MOD
     if (port >= TY_GPIO_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
         return GPIO_ERR_INVALID_PARM;
     }
 
@@ -165,7 +200,7 @@ GPIO_RET tuya_gpio_set_inout(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T in)
     if (port >= TY_GPIO_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
         return GPIO_ERR_INVALID_PARM;
     }
 
@@ -191,7 +226,7 @@ GPIO_RET tuya_gpio_set_mode(IN CONST TY_GPIO_PORT_E port, IN CONST TY_GPIO_MODE_
     if (port >= TY_GPIO_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
         return GPIO_ERR_INVALID_PARM;
     }
 
@@ -211,7 +246,7 @@ GPIO_RET tuya_gpio_write(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T level)
     if (port >= TY_GPIO_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
         return GPIO_ERR_INVALID_PARM;
     }
 
@@ -230,7 +265,7 @@ BOOL_T tuya_gpio_read(IN CONST TY_GPIO_PORT_E port)
     if (port >= TY_GPIO_MAX) {
         return 0;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
         return 0;
     }
 
@@ -238,88 +273,688 @@ BOOL_T tuya_gpio_read(IN CONST TY_GPIO_PORT_E port)
 }
 
 /**
- * @brief tuya gpio interrupt init
+ * @brief tuya gpio resolve a pin, checked once for tuya_gpio_pin_read() and tuya_gpio_pin_write()
  * @param[in] port: gpio number
- * @param[in] trig_type: trigger type
- * @param[in] irq_cb: interrupt callback function
+ * @param[out] pin: resolved pin
  * @return GPIO_RET
  */
-GPIO_RET tuya_gpio_irq_init(IN CONST TY_GPIO_PORT_E port, IN CONST TY_GPIO_IRQ_TYPE_E trig_type, IN TY_GPIO_IRQ_CB irq_cb)
+GPIO_RET tuya_gpio_pin_get(IN CONST TY_GPIO_PORT_E port, OUT TY_GPIO_PIN_T *pin)
 {
-    if (port >= TY_GPIO_MAX) {
+    if ((port >= TY_GPIO_MAX) || (NULL == pin)) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    pin->in = &reg_gpio_in(sg_pf_pin_list[port]);
+    pin->out = &reg_gpio_out(sg_pf_pin_list[port]);
+    pin->mask = TY_GPIO_PORT_TO_MASK(port);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio read bank
+ * @param[in] bank: gpio bank
+ * @return input levels of the bank, bit n is the level of pin n (TY_GPIOx_n)
+ */
+UCHAR_T tuya_gpio_read_bank(IN CONST TY_GPIO_BANK_E bank)
+{
+    if (bank >= TY_GPIO_BANK_MAX) {
+        return 0;
+    }
+
+    return reg_gpio_in(bank << 8);
+}
+
+/**
+ * @brief tuya gpio set the output of the bank pins in the mask to high, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to set, bit n - pin n (TY_GPIOx_n), see TY_GPIO_PORT_TO_MASK()
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_set_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask)
+{
+    if (bank >= TY_GPIO_BANK_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    reg_gpio_out(bank << 8) |= (mask & sg_bank_pin_mask[bank]);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio set the output of the bank pins in the mask to low, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to clear, bit n - pin n (TY_GPIOx_n)
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_clr_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask)
+{
+    if (bank >= TY_GPIO_BANK_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
-    if (-1 == sg_pf_pin_list[port]) {
+
+    reg_gpio_out(bank << 8) &= ~(mask & sg_bank_pin_mask[bank]);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio toggle the output of the bank pins in the mask, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to toggle, bit n - pin n (TY_GPIOx_n)
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_toggle_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask)
+{
+    if (bank >= TY_GPIO_BANK_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    reg_gpio_out(bank << 8) ^= (mask & sg_bank_pin_mask[bank]);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio write the output of the bank pins in the mask, one register write
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins to write, bit n - pin n (TY_GPIOx_n)
+ * @param[in] level: output levels, bit n - level of pin n
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_write_bank(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask, IN CONST UCHAR_T level)
+{
+    UCHAR_T pins;
+
+    if (bank >= TY_GPIO_BANK_MAX) {
         return GPIO_ERR_INVALID_PARM;
     }
 
-    /* allocate and clear for hall_sw_mag */
-    TY_GPIO_IRQ_MAG_T *irq_mag_tmp = (TY_GPIO_IRQ_MAG_T *)tuya_ble_malloc(SIZEOF(TY_GPIO_IRQ_MAG_T));
-    if (NULL == irq_mag_tmp) {
-        return GPIO_ERR_MALLOC_FAILED;
+    pins = mask & sg_bank_pin_mask[bank];
+    reg_gpio_out(bank << 8) = (reg_gpio_out(bank << 8) & ~pins) | (level & pins);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief remove the interrupt of the port
+ * @param[in] port: gpio number
+ * @return none
+ */
+STATIC VOID_T __gpio_irq_del(IN CONST TY_GPIO_PORT_E port)
+{
+    TY_GPIO_BANK_E bank = TY_GPIO_PORT_TO_BANK(port);
+    UCHAR_T mask = ~(1 << TY_GPIO_PORT_TO_BIT(port));
+
+    gpio_en_interrupt_risc0(sg_pf_pin_list[port], FALSE);
+    gpio_en_interrupt_risc1(sg_pf_pin_list[port], FALSE);
+    sg_rise_mask[bank] &= mask;
+    sg_fall_mask[bank] &= mask;
+    sg_both_mask[bank] &= mask;
+    sg_edge_mask[bank] &= mask;
+    sg_irq_off_mask[bank] &= mask;
+    if (sg_holdoff_busy[bank] & ~mask) {
+        gpio_en_interrupt(sg_pf_pin_list[port], FALSE);
+    }
+    sg_holdoff_busy[bank] &= mask;
+    sg_holdoff_pend[bank] &= mask;
+}
+
+/**
+ * @brief enable a gpio interrupt channel, shared by the pins of all banks
+ * @param[in] irq_src: FLD_IRQ_GPIO_RISC0_EN or FLD_IRQ_GPIO_RISC1_EN
+ * @return none
+ */
+STATIC VOID_T __gpio_irq_channel_en(IN CONST UINT_T irq_src)
+{
+    /* clear a stale request only once, later it may be the edge of another pin */
+    if (!(reg_irq_mask & irq_src)) {
+        reg_irq_src = irq_src;
+        reg_irq_mask |= irq_src;
+    }
+}
+
+/**
+ * @brief set the interrupt of the port, replaces the old one
+ * @param[in] port: gpio number
+ * @param[in] trig_type: trigger type
+ * @param[in] irq_cb: interrupt callback function, both edges: NULL - queued in the edge fifo
+ * @return none
+ */
+STATIC VOID_T __gpio_irq_set(IN CONST TY_GPIO_PORT_E port, IN CONST TY_GPIO_IRQ_TYPE_E trig_type, IN TY_GPIO_IRQ_CB irq_cb)
+{
+    TY_GPIO_BANK_E bank = TY_GPIO_PORT_TO_BANK(port);
+    UCHAR_T bit_mask = 1 << TY_GPIO_PORT_TO_BIT(port);
+
+    __gpio_irq_del(port);
+    sg_irq_cb_tab[port] = irq_cb;
+    if (TY_GPIO_IRQ_NONE == trig_type) {
+        return;
     }
-    irq_mag_tmp->port = port;
-    irq_mag_tmp->irq_cb = irq_cb;
+
+    /* one polarity per pin: wait for the other level, flipped on each edge,
+       so a pin held at its active level does not block the other pins of the channel */
+    if (gpio_read(sg_pf_pin_list[port])) {
+        sg_irq_level[bank] |= bit_mask;
+    } else {
+        sg_irq_level[bank] &= ~bit_mask;
+    }
+    gpio_set_interrupt_pol(sg_pf_pin_list[port], (sg_irq_level[bank] & bit_mask) ? pol_falling : pol_rising);
 
     switch (trig_type) {
-    case TY_GPIO_IRQ_NONE:
-        break;
     case TY_GPIO_IRQ_RISING:
-        if (sg_rise_mag_list) {
-    	    irq_mag_tmp->next = sg_rise_mag_list;
-        }
-        sg_rise_mag_list = irq_mag_tmp;
-        gpio_set_interrupt_pol(sg_pf_pin_list[port], pol_rising);
-	    reg_irq_src = FLD_IRQ_GPIO_RISC0_EN;
-	    reg_irq_mask |= FLD_IRQ_GPIO_RISC0_EN;
-	    gpio_en_interrupt_risc0(sg_pf_pin_list[port], TRUE);
+        sg_rise_mask[bank] |= bit_mask;
+        __gpio_irq_channel_en(FLD_IRQ_GPIO_RISC0_EN);
+        gpio_en_interrupt_risc0(sg_pf_pin_list[port], TRUE);
         break;
     case TY_GPIO_IRQ_FALLING:
-        if (sg_fall_mag_list) {
-    	    irq_mag_tmp->next = sg_fall_mag_list;
+        sg_fall_mask[bank] |= bit_mask;
+        __gpio_irq_channel_en(FLD_IRQ_GPIO_RISC1_EN);
+        gpio_en_interrupt_risc1(sg_pf_pin_list[port], TRUE);
+        break;
+    case TY_GPIO_IRQ_BOTH:
+        sg_both_mask[bank] |= bit_mask;
+        if (NULL == irq_cb) {
+            sg_edge_mask[bank] |= bit_mask;
         }
-        sg_fall_mag_list = irq_mag_tmp;
-        gpio_set_interrupt_pol(sg_pf_pin_list[port], pol_falling);
-	    reg_irq_src = FLD_IRQ_GPIO_RISC1_EN;
-	    reg_irq_mask |= FLD_IRQ_GPIO_RISC1_EN;
-	    gpio_en_interrupt_risc1(sg_pf_pin_list[port], TRUE);
+        __gpio_irq_channel_en(FLD_IRQ_GPIO_RISC0_EN);
+        gpio_en_interrupt_risc0(sg_pf_pin_list[port], TRUE);
         break;
     default:
         break;
     }
+}
+
+/**
+ * @brief tuya gpio interrupt init, a new init of the port replaces the old one
+ * @param[in] port: gpio number
+ * @param[in] trig_type: trigger type
+ * @param[in] irq_cb: interrupt callback function
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_init(IN CONST TY_GPIO_PORT_E port, IN CONST TY_GPIO_IRQ_TYPE_E trig_type, IN TY_GPIO_IRQ_CB irq_cb)
+{
+    if (port >= TY_GPIO_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if ((trig_type != TY_GPIO_IRQ_NONE) && (NULL == irq_cb)) {
+        return GPIO_ERR_CB_UNDEFINED;
+    }
+
+    __gpio_irq_set(port, trig_type, irq_cb);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio interrupt deinit
+ * @param[in] port: gpio number
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_deinit(IN CONST TY_GPIO_PORT_E port)
+{
+    if (port >= TY_GPIO_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    __gpio_irq_del(port);
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio edge init, both edges of the port are timestamped in the interrupt
+ *        and queued in one fifo shared by all edge ports, in the order they happened
+ * @param[in] port: gpio number
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_edge_init(IN CONST TY_GPIO_PORT_E port)
+{
+    if (port >= TY_GPIO_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if (TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    __gpio_irq_set(port, TY_GPIO_IRQ_BOTH, NULL);
 
     return GPIO_OK;
 }
 
 /**
- * @brief gpio rising irq handler
+ * @brief enable the interrupt of the port again, its level is taken as the last edge
+ * @param[in] port: gpio number
+ * @return none
+ */
+STATIC VOID_T __gpio_irq_en(IN CONST TY_GPIO_PORT_E port)
+{
+    TY_GPIO_BANK_E bank = TY_GPIO_PORT_TO_BANK(port);
+    UCHAR_T bit_mask = TY_GPIO_PORT_TO_MASK(port);
+
+    if (gpio_read(sg_pf_pin_list[port])) {
+        sg_irq_level[bank] |= bit_mask;
+    } else {
+        sg_irq_level[bank] &= ~bit_mask;
+    }
+    gpio_set_interrupt_pol(sg_pf_pin_list[port], (sg_irq_level[bank] & bit_mask) ? pol_falling : pol_rising);
+    if (sg_fall_mask[bank] & bit_mask) {
+        gpio_en_interrupt_risc1(sg_pf_pin_list[port], TRUE);
+    } else {
+        gpio_en_interrupt_risc0(sg_pf_pin_list[port], TRUE);
+    }
+}
+
+/**
+ * @brief tuya gpio interrupt enable of a port, the interrupt setting is kept while disabled,
+ *        the edges while disabled are not reported
+ * @param[in] port: gpio number with an interrupt
+ * @param[in] enable: TRUE - enable, FALSE - disable
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_set_enable(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T enable)
+{
+    TY_GPIO_BANK_E bank;
+    UCHAR_T bit_mask;
+
+    if (port >= TY_GPIO_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    bank = TY_GPIO_PORT_TO_BANK(port);
+    bit_mask = TY_GPIO_PORT_TO_MASK(port);
+    if (0 == ((sg_rise_mask[bank] | sg_fall_mask[bank] | sg_both_mask[bank]) & bit_mask)) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    if (!enable) {
+        sg_irq_off_mask[bank] |= bit_mask;
+        gpio_en_interrupt_risc0(sg_pf_pin_list[port], FALSE);
+        gpio_en_interrupt_risc1(sg_pf_pin_list[port], FALSE);
+        return GPIO_OK;
+    }
+    if (sg_irq_off_mask[bank] & bit_mask) {
+        sg_irq_off_mask[bank] &= ~bit_mask;
+        /* a pin in hold-off is enabled again by the timer */
+        if (!(sg_holdoff_busy[bank] & bit_mask)) {
+            __gpio_irq_en(port);
+        }
+    }
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief get the oldest queued edge, single consumer
+ * @param[out] edge: gpio edge
+ * @return TRUE - an edge was queued, FALSE - fifo empty
+ */
+BOOL_T tuya_gpio_edge_get(OUT TY_GPIO_EDGE_T *edge)
+{
+    UCHAR_T tail = sg_edge_tail;
+
+    if (tail == sg_edge_head) {
+        return FALSE;
+    }
+    *edge = sg_edge_fifo[tail & TY_GPIO_EDGE_FIFO_MASK];
+    /* release the slot after it has been read */
+    sg_edge_tail = tail + 1;
+    return TRUE;
+}
+
+/**
+ * @brief get the number of edges lost because the edge fifo was full
+ * @param[in] none
+ * @return lost edges
+ */
+UINT_T tuya_gpio_edge_get_lost_cnt(VOID_T)
+{
+    return sg_edge_lost_cnt;
+}
+
+/**
+ * @brief queue the edges of the edge pins, called by the irq only
+ * @param[in] bank: gpio bank
+ * @param[in] edges: changed edge pins, bit n - pin n of the bank
+ * @param[in] level: input levels of the bank
+ * @return none
+ */
+STATIC VOID_T __gpio_edge_push(IN CONST TY_GPIO_BANK_E bank, IN UCHAR_T edges, IN CONST UCHAR_T level)
+{
+    UINT_T time = tuya_get_clock_time();
+    UCHAR_T head = sg_edge_head;
+    UCHAR_T bit;
+    volatile TY_GPIO_EDGE_T *edge;
+
+    while (edges) {
+        bit = __builtin_ctz(edges);
+        edges &= edges - 1;
+        if ((UCHAR_T)(head - sg_edge_tail) >= TY_GPIO_EDGE_FIFO_SIZE) {
+            sg_edge_lost_cnt++;
+            continue;
+        }
+        edge = &sg_edge_fifo[head & TY_GPIO_EDGE_FIFO_MASK];
+        edge->port = (TY_GPIO_PORT_E)(bank * TY_GPIO_BANK_PIN_NUM + bit);
+        edge->level = (level >> bit) & 0x01;
+        edge->time = time;
+        head++;
+    }
+    /* publish the edges after they have been written */
+    sg_edge_head = head;
+}
+
+/**
+ * @brief call the interrupt callbacks of the fired pins
+ * @param[in] bank: gpio bank
+ * @param[in] fired: fired pins, bit n - pin n of the bank
+ * @return none
+ */
+STATIC VOID_T __gpio_irq_dispatch(IN CONST TY_GPIO_BANK_E bank, IN UCHAR_T fired)
+{
+    TY_GPIO_PORT_E port;
+
+    while (fired) {
+        port = (TY_GPIO_PORT_E)(bank * TY_GPIO_BANK_PIN_NUM + __builtin_ctz(fired));
+        fired &= fired - 1;
+        sg_irq_cb_tab[port](port);
+    }
+}
+
+/**
+ * @brief handle the changed interrupt pins: the polarity follows the new level,
+ *        the edges of the trigger type are queued or passed to the callbacks
+ * @param[in] bank: gpio bank
+ * @param[in] changed: changed interrupt pins, bit n - pin n of the bank
+ * @param[in] level: input levels of the bank
+ * @return none
+ */
+STATIC VOID_T __gpio_irq_edge(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T changed, IN CONST UCHAR_T level)
+{
+    UCHAR_T flip = changed;
+    UCHAR_T bit, edges;
+
+    sg_irq_level[bank] ^= changed;
+    while (flip) {
+        bit = __builtin_ctz(flip);
+        flip &= flip - 1;
+        gpio_set_interrupt_pol(sg_pf_pin_list[bank * TY_GPIO_BANK_PIN_NUM + bit],
+                               ((level >> bit) & 0x01) ? pol_falling : pol_rising);
+    }
+    if (changed & sg_edge_mask[bank]) {
+        __gpio_edge_push(bank, changed & sg_edge_mask[bank], level);
+    }
+    edges = (changed & sg_both_mask[bank] & ~sg_edge_mask[bank]) |
+            (changed & level & sg_rise_mask[bank]) |
+            (changed & ~level & sg_fall_mask[bank]);
+    __gpio_irq_dispatch(bank, edges);
+}
+
+/**
+ * @brief mask the hold-off pins that just had an edge, called in interrupt context only
+ * @param[in] bank: gpio bank
+ * @param[in] pins: pins with an edge, bit n - pin n of the bank
+ * @param[in] level: input levels of the bank
+ * @return none
+ */
+STATIC VOID_T __gpio_holdoff_start(IN CONST TY_GPIO_BANK_E bank, IN UCHAR_T pins, IN CONST UCHAR_T level)
+{
+    TY_GPIO_PORT_E port;
+
+    pins &= sg_holdoff_mask[bank];
+    if (0 == pins) {
+        return;
+    }
+    if (!sg_holdoff_running) {
+        /* no pin was masked, the latch is stale */
+        reg_irq_src = FLD_IRQ_GPIO_EN;
+    }
+    sg_holdoff_level[bank] = (sg_holdoff_level[bank] & ~pins) | (level & pins);
+    sg_holdoff_busy[bank] |= pins;
+    sg_holdoff_pend[bank] &= ~pins;
+    while (pins) {
+        port = (TY_GPIO_PORT_E)(bank * TY_GPIO_BANK_PIN_NUM + __builtin_ctz(pins));
+        pins &= pins - 1;
+        gpio_en_interrupt_risc0(sg_pf_pin_list[port], FALSE);
+        gpio_en_interrupt_risc1(sg_pf_pin_list[port], FALSE);
+        /* the polarity waits for the other level, the next edge sets the latch */
+        gpio_en_interrupt(sg_pf_pin_list[port], TRUE);
+        /* the first tick may come early, one more makes the full hold-off time */
+        sg_holdoff_tick[port] = TY_GPIO_HOLDOFF_DIV + 1;
+        sg_holdoff_stat.holdoff_cnt++;
+    }
+    if (!sg_holdoff_running) {
+        sg_holdoff_running = TRUE;
+        tuya_hardware_timer_start(sg_holdoff_timer);
+    }
+}
+
+/**
+ * @brief end the hold-off of a pin and enable its interrupt again, called in interrupt context only
+ * @param[in] bank: gpio bank
+ * @param[in] bit: pin of the bank
+ * @return none
+ */
+STATIC VOID_T __gpio_holdoff_end(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T bit)
+{
+    GPIO_PinTypeDef pin = sg_pf_pin_list[bank * TY_GPIO_BANK_PIN_NUM + bit];
+    UCHAR_T mask = 1 << bit;
+    UCHAR_T level = reg_gpio_in(bank << 8);
+
+    gpio_en_interrupt(pin, FALSE);
+    sg_holdoff_busy[bank] &= ~mask;
+    /* an edge back to the masked level is seen by the latch only */
+    if (((level ^ sg_holdoff_level[bank]) | sg_holdoff_pend[bank]) & mask) {
+        sg_holdoff_stat.suppress_cnt++;
+    }
+    sg_holdoff_pend[bank] &= ~mask;
+    /* a disabled pin is enabled again by tuya_gpio_irq_set_enable() */
+    if (0 == ((sg_rise_mask[bank] | sg_fall_mask[bank] | sg_both_mask[bank]) & ~sg_irq_off_mask[bank] & mask)) {
+        return;
+    }
+    /* the edges hidden by the hold-off give one edge to the final level, which is held off again */
+    if ((level ^ sg_irq_level[bank]) & mask) {
+        __gpio_irq_edge(bank, mask, level);
+        __gpio_holdoff_start(bank, mask, level);
+        return;
+    }
+    if (sg_fall_mask[bank] & mask) {
+        gpio_en_interrupt_risc1(pin, TRUE);
+    } else {
+        gpio_en_interrupt_risc0(pin, TRUE);
+    }
+}
+
+/**
+ * @brief take the latched edge of the masked pins, called in interrupt context only
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __gpio_holdoff_latch_take(VOID_T)
+{
+    TY_GPIO_BANK_E bank;
+    UCHAR_T moved[TY_GPIO_BANK_MAX];
+    UCHAR_T pins, bit, any = 0;
+
+    if (!(reg_irq_src & FLD_IRQ_GPIO_EN)) {
+        return;
+    }
+    reg_irq_src = FLD_IRQ_GPIO_EN;
+    for (bank = 0; bank < TY_GPIO_BANK_MAX; bank++) {
+        moved[bank] = (reg_gpio_in(bank << 8) ^ sg_holdoff_level[bank]) & sg_holdoff_busy[bank] & ~sg_holdoff_pend[bank];
+        any |= moved[bank];
+    }
+    for (bank = 0; bank < TY_GPIO_BANK_MAX; bank++) {
+        /* the latch is shared: the pins away from their masked level, else all of them
+           as the edge went back already */
+        pins = any ? moved[bank] : (sg_holdoff_busy[bank] & ~sg_holdoff_pend[bank]);
+        sg_holdoff_pend[bank] |= pins;
+        /* off the latch, so it can take the edge of another pin */
+        while (pins) {
+            bit = __builtin_ctz(pins);
+            pins &= pins - 1;
+            gpio_en_interrupt(sg_pf_pin_list[bank * TY_GPIO_BANK_PIN_NUM + bit], FALSE);
+        }
+    }
+}
+
+/**
+ * @brief hold-off timer callback, counts down the masked pins
+ * @param[in] none
+ * @return 0
+ */
+STATIC INT_T __gpio_holdoff_timeout_handler(VOID_T)
+{
+    TY_GPIO_BANK_E bank;
+    UCHAR_T pins, bit, busy = 0;
+
+    __gpio_holdoff_latch_take();
+    for (bank = 0; bank < TY_GPIO_BANK_MAX; bank++) {
+        pins = sg_holdoff_busy[bank];
+        while (pins) {
+            bit = __builtin_ctz(pins);
+            pins &= pins - 1;
+            if (0 == --sg_holdoff_tick[bank * TY_GPIO_BANK_PIN_NUM + bit]) {
+                __gpio_holdoff_end(bank, bit);
+            }
+        }
+        busy |= sg_holdoff_busy[bank];
+    }
+    if (0 == busy) {
+        tuya_hardware_timer_stop(sg_holdoff_timer);
+        sg_holdoff_running = FALSE;
+    }
+    return 0;
+}
+
+/**
+ * @brief tuya gpio interrupt hold-off init: a pin with hold-off is masked for the hold-off time after
+ *        each edge, its interrupt is enabled again from the hardware timer, called once,
+ *        the plain gpio interrupt channel (FLD_IRQ_GPIO_EN) latches the edges of the masked pins
+ * @param[in] timer: hardware timer used for the hold-off
+ * @param[in] holdoff_us: hold-off time (us)
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_holdoff_init(IN CONST TY_HW_TIMER_TYPE_E timer, IN CONST UINT_T holdoff_us)
+{
+    if (sg_holdoff_init || (holdoff_us < TY_GPIO_HOLDOFF_DIV)) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if (TIMER_OK != tuya_hardware_timer_create(timer, holdoff_us / TY_GPIO_HOLDOFF_DIV,
+                                               __gpio_holdoff_timeout_handler, TY_TIMER_REPEAT)) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    /* runs only while a pin is masked */
+    tuya_hardware_timer_stop(timer);
+    /* the latch of the masked pins, never an interrupt */
+    reg_irq_mask &= ~FLD_IRQ_GPIO_EN;
+    reg_gpio_wakeup_irq |= FLD_GPIO_CORE_INTERRUPT_EN;
+    sg_holdoff_timer = timer;
+    sg_holdoff_init = TRUE;
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief tuya gpio interrupt hold-off of a port, limits the interrupt rate of a bouncing pin,
+ *        a pin whose level changed meanwhile gets one edge to the final level
+ * @param[in] port: gpio number
+ * @param[in] enable: TRUE - hold-off after each edge, FALSE - every edge interrupts
+ * @return GPIO_RET
+ */
+GPIO_RET tuya_gpio_irq_set_holdoff(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T enable)
+{
+    if (port >= TY_GPIO_MAX) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+    if ((TY_GPIO_PIN_NONE == sg_pf_pin_list[port]) || !sg_holdoff_init) {
+        return GPIO_ERR_INVALID_PARM;
+    }
+
+    /* a masked pin is enabled again by the timer */
+    if (enable) {
+        sg_holdoff_mask[TY_GPIO_PORT_TO_BANK(port)] |= TY_GPIO_PORT_TO_MASK(port);
+    } else {
+        sg_holdoff_mask[TY_GPIO_PORT_TO_BANK(port)] &= ~TY_GPIO_PORT_TO_MASK(port);
+    }
+
+    return GPIO_OK;
+}
+
+/**
+ * @brief get gpio interrupt hold-off statistics
+ * @param[out] stat: hold-off statistics
+ * @return none
+ */
+VOID_T tuya_gpio_get_holdoff_stat(OUT TY_GPIO_HOLDOFF_STAT_T *stat)
+{
+    stat->irq_cnt = sg_holdoff_stat.irq_cnt;
+    stat->holdoff_cnt = sg_holdoff_stat.holdoff_cnt;
+    stat->suppress_cnt = sg_holdoff_stat.suppress_cnt;
+}
+
+/**
+ * @brief clear gpio interrupt hold-off statistics
+ * @param[in] none
+ * @return none
+ */
+VOID_T tuya_gpio_clr_holdoff_stat(VOID_T)
+{
+    sg_holdoff_stat.irq_cnt = 0;
+    sg_holdoff_stat.holdoff_cnt = 0;
+    sg_holdoff_stat.suppress_cnt = 0;
+}
+
+/**
+ * @brief gpio rising irq handler (rising and both edge pins), one input read per bank with interrupt pins
  * @param[in] none
  * @return none
  */
 STATIC VOID_T __gpio_irq_rising_handler(VOID_T)
 {
-    TY_GPIO_IRQ_MAG_T *irq_mag_tmp = sg_rise_mag_list;
-    while (irq_mag_tmp) {
-        if (gpio_read(sg_pf_pin_list[irq_mag_tmp->port])) {
-            irq_mag_tmp->irq_cb(irq_mag_tmp->port);
+    TY_GPIO_BANK_E bank;
+    UCHAR_T level, changed;
+
+    for (bank = 0; bank < TY_GPIO_BANK_MAX; bank++) {
+        if (0 == (sg_rise_mask[bank] | sg_both_mask[bank])) {
+            continue;
         }
-        irq_mag_tmp = irq_mag_tmp->next;
+        level = reg_gpio_in(bank << 8);
+        /* only the pins whose level changed, masked pins are checked when the hold-off ends,
+           disabled pins when they are enabled */
+        changed = (level ^ sg_irq_level[bank]) & (sg_rise_mask[bank] | sg_both_mask[bank]) &
+                  ~(sg_holdoff_busy[bank] | sg_irq_off_mask[bank]);
+        __gpio_irq_edge(bank, changed, level);
+        __gpio_holdoff_start(bank, changed, level);
     }
 }
 
 /**
- * @brief gpio falling irq handler
+ * @brief gpio falling irq handler (falling pins), one input read per bank with interrupt pins
  * @param[in] none
  * @return none
  */
 STATIC VOID_T __gpio_irq_falling_handler(VOID_T)
 {
-    TY_GPIO_IRQ_MAG_T *irq_mag_tmp = sg_fall_mag_list;
-    while (irq_mag_tmp) {
-        if (!gpio_read(sg_pf_pin_list[irq_mag_tmp->port])) {
-            irq_mag_tmp->irq_cb(irq_mag_tmp->port);
+    TY_GPIO_BANK_E bank;
+    UCHAR_T level, changed;
+
+    for (bank = 0; bank < TY_GPIO_BANK_MAX; bank++) {
+        if (0 == sg_fall_mask[bank]) {
+            continue;
         }
-        irq_mag_tmp = irq_mag_tmp->next;
+        level = reg_gpio_in(bank << 8);
+        changed = (level ^ sg_irq_level[bank]) & sg_fall_mask[bank] & ~(sg_holdoff_busy[bank] | sg_irq_off_mask[bank]);
+        __gpio_irq_edge(bank, changed, level);
+        __gpio_holdoff_start(bank, changed, level);
     }
 }
 
@@ -330,6 +965,7 @@ STATIC VOID_T __gpio_irq_falling_handler(VOID_T)
  */
 VOID_T tuya_gpio_irq_handler(VOID_T)
 {
+    sg_holdoff_stat.irq_cnt++;
 	if(reg_irq_src & FLD_IRQ_GPIO_RISC0_EN){
 		reg_irq_src = FLD_IRQ_GPIO_RISC0_EN;
         __gpio_irq_rising_handler();
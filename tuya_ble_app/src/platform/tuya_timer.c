@@ -89,19 +89,6 @@ STATIC BOOL_T __is_hardware_timer_used(IN CONST TY_HW_TIMER_TYPE_E type)
     return FALSE;
 }
 
-/**
- * @brief is hardware timer busy
- * @param[in] type: timer type
- * @return TRUE - busy, FALSE - not busy
- */
-STATIC BOOL_T __is_hardware_timer_busy(IN CONST TY_HW_TIMER_TYPE_E type)
-{
-    if (sg_hw_timer_status[type] == TY_TIMER_USED_BUSY) {
-        return TRUE;
-    }
-    return FALSE;
-}
-
 /**
  * @brief mask hardware timer status
  * @param[in] type: timer type
@@ -269,3 +256,15 @@ BOOL_T tuya_is_clock_time_exceed(IN CONST UINT_T prv_time, IN CONST UINT_T time_
         return FALSE;
     }
 }
+
+/**
+ * @brief tuya get clock time difference, handles the clock wraparound
+ * @param[in] prv_time: previous clock time
+ * @param[in] cur_time: current clock time
+ * @return time difference (us)
+ */
+UINT_T tuya_get_clock_time_diff_us(IN CONST UINT_T prv_time, IN CONST UINT_T cur_time)
+{
+    /* unsigned subtraction stays correct across one wraparound */
+    return (UINT_T)(cur_time - prv_time) / CLOCK_SYS_CLOCK_1US;
+}
@@ -29,6 +29,8 @@
 #include "tuya_ble_common.h"
 #include "tuya_demo_key_driver.h"
 #include "tuya_timer.h"
+#include "tuya_gpio.h"
+#include "tuya_key.h"
 
 /***********************************************************
 ************************micro define************************
@@ -277,7 +279,7 @@ void tuya_ble_app_init(void)
  */
 void app_exe()
 {
-
+    tuya_key_loop();
 }
 
 /**
@@ -288,4 +290,5 @@ void app_exe()
 void tuya_ble_app_irq_handler(void)
 {
     tuya_timer_irq_handler();
+    tuya_gpio_irq_handler();
 }
@@ -36,19 +36,21 @@ typedef BYTE_T KEY_EVENT_E;
 /* KEY user define */
 STATIC VOID_T __key1_cb(KEY_PRESS_TYPE_E type);
 STATIC VOID_T __key2_cb(KEY_PRESS_TYPE_E type);
-KEY_DEF_T key1_def_s = {
-    .port = TY_GPIOB_7,
-    .active_low = TRUE,
-    .long_press_time1 = 2000,
-    .long_press_time2 = 5000,
-    .key_cb = __key1_cb
-};
-KEY_DEF_T key2_def_s = {
-    .port = TY_GPIOB_1,
-    .active_low = TRUE,
-    .long_press_time1 = 8000,
-    .long_press_time2 = 3000,
-    .key_cb = __key2_cb
+STATIC CONST KEY_DEF_T sg_key_def_tab[] = {
+    {   /* mode key */
+        .port = TY_GPIOB_7,
+        .active_low = TRUE,
+        .long_press_time1 = 2000,
+        .long_press_time2 = 5000,
+        .key_cb = __key1_cb
+    },
+    {   /* reset key */
+        .port = TY_GPIOB_1,
+        .active_low = TRUE,
+        .long_press_time1 = 8000,
+        .long_press_time2 = 3000,
+        .key_cb = __key2_cb
+    }
 };
 /* KEY event data */
 STATIC KEY_EVENT_E sg_key_event = KEY1_SHORT_PRESS;
@@ -137,14 +139,14 @@ STATIC VOID_T __key2_cb(KEY_PRESS_TYPE_E type)
 VOID_T tuya_key_driver_init(VOID_T)
 {
     KEY_RET ret = KEY_OK;
-    /* register mode key */
-    ret = tuya_reg_key(&key1_def_s);
+    /* scan keys only after a key edge to save power */
+    ret = tuya_key_set_scan_mode(KEY_SCAN_MODE_EDGE);
     if (KEY_OK != ret) {
-        TUYA_APP_LOG_ERROR("key1 init error: %d", ret);
+        TUYA_APP_LOG_ERROR("key scan mode set error: %d", ret);
     }
-    /* register reset key */
-    ret = tuya_reg_key(&key2_def_s);
+    /* register mode key and reset key */
+    ret = tuya_reg_key_table(sg_key_def_tab, KEY_TAB_SIZE(sg_key_def_tab));
     if (KEY_OK != ret) {
-        TUYA_APP_LOG_ERROR("key2 init error: %d", ret);
+        TUYA_APP_LOG_ERROR("key init error: %d", ret);
     }
 }
@@ -0,0 +1,42 @@
+/**
+ * @file bench.h
+ * @author agent
+ * @brief host benchmark helpers
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdio.h>
+#include <time.h>
+#include "tuya_common.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+/* print a result table title and its column header */
+#define BENCH_TITLE(title, header) printf("\n%s\n%s\n", (title), (header))
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief host monotonic time, only host code is timed with it, the simulated
+ *        board is measured in simulated time and counts
+ * @param[in] none
+ * @return time (ns)
+ */
+STATIC INLINE UDLONG_T bench_now_ns(VOID_T)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (UDLONG_T)ts.tv_sec * 1000000000ull + (UDLONG_T)ts.tv_nsec;
+}
+
+#endif /* __BENCH_H__ */
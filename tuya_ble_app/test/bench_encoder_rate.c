@@ -0,0 +1,152 @@
+/**
+ * @file bench_encoder_rate.c
+ * @author agent
+ * @brief rotary encoder step rate sweep, the fastest rate decoded without errors
+ *        at an interrupt service latency
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "bench.h"
+#include "sim.h"
+#include "tuya_encoder.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define ENC_A_PORT          TY_GPIOB_4
+#define ENC_B_PORT          TY_GPIOB_5
+#define ENC_AB_MASK         (TY_GPIO_PORT_TO_MASK(ENC_A_PORT) | TY_GPIO_PORT_TO_MASK(ENC_B_PORT))
+#define DETENT_NUM          100     /* detents of a run */
+#define STEP_NUM            (DETENT_NUM * 4)
+#define LATENCY_NUM         3
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+/* edge to pin read of the interrupt: a short handler, and the interrupts held off by the stack */
+STATIC CONST UINT_T sg_latency_us[LATENCY_NUM] = {10, 50, 200};
+STATIC CONST UINT_T sg_step_rate[] = {100, 500, 1000, 2000, 5000, 10000, 20000, 50000, 100000};
+
+STATIC INT_T sg_detent = 0;
+STATIC UINT_T sg_seed = 1;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __encoder_cb(INT_T detent, UINT_T velocity)
+{
+    sg_detent += detent;
+}
+
+/**
+ * @brief step time random numbers, the same sequence in each run
+ * @param[in] min: min value
+ * @param[in] max: max value
+ * @return random value in min - max
+ */
+STATIC UINT_T __rand_range(IN CONST UINT_T min, IN CONST UINT_T max)
+{
+    sg_seed = sg_seed * 1103515245 + 12345;
+    return min + ((sg_seed >> 8) % (max - min + 1));
+}
+
+/**
+ * @brief pin levels of a clockwise quadrature step, active low
+ * @param[in] step: step number
+ * @return bank level of A and B
+ */
+STATIC UCHAR_T __step_level(IN CONST UINT_T step)
+{
+    STATIC CONST UCHAR_T cw_seq[4] = {0x02, 0x03, 0x01, 0x00};   /* bit 1 - A, bit 0 - B, 1 - active */
+    UCHAR_T ab = cw_seq[step & 3], level = ENC_AB_MASK;
+
+    if (ab & 0x02) {
+        level &= ~TY_GPIO_PORT_TO_MASK(ENC_A_PORT);
+    }
+    if (ab & 0x01) {
+        level &= ~TY_GPIO_PORT_TO_MASK(ENC_B_PORT);
+    }
+    return level;
+}
+
+/**
+ * @brief turn DETENT_NUM detents clockwise, the step times vary by +-50 % as a hand turns,
+ *        the edges arriving before the interrupt reads the pins are seen at once
+ * @param[in] rate: mean steps per second
+ * @param[in] latency_us: edge to pin read of the interrupt
+ * @param[out] detent: detents reported
+ * @return decode errors
+ */
+STATIC UINT_T __rate_run(IN CONST UINT_T rate, IN CONST UINT_T latency_us, OUT INT_T *detent)
+{
+    STATIC UINT_T edge_us[STEP_NUM];
+    ENCODER_STAT_T stat;
+    UINT_T step_us = 1000000 / rate;
+    UINT_T start_us, err_start, i, j;
+
+    tuya_encoder_get_stat(&stat);
+    err_start = stat.error_cnt;
+    sg_seed = 1;
+    start_us = sim_time_us() + step_us;
+    for (i = 0; i < STEP_NUM; i++) {
+        edge_us[i] = start_us;
+        start_us += __rand_range(step_us / 2, step_us + step_us / 2);
+    }
+
+    sg_detent = 0;
+    for (i = 0; i < STEP_NUM; i = j) {
+        if ((INT_T)(edge_us[i] - sim_time_us()) > 0) {
+            sim_run_us(edge_us[i] - sim_time_us());
+        }
+        for (j = i + 1; (j < STEP_NUM) && ((edge_us[j] - edge_us[i]) < latency_us); j++) {
+            ;
+        }
+        sim_bank_drive(TY_GPIO_BANK_B, ENC_AB_MASK, __step_level(j - 1));
+    }
+    sim_run_ms(100);
+    tuya_encoder_loop();
+    *detent = sg_detent;
+
+    tuya_encoder_get_stat(&stat);
+    return stat.error_cnt - err_start;
+}
+
+int main(int argc, char *argv[])
+{
+    STATIC ENCODER_DEF_T enc = {ENC_A_PORT, ENC_B_PORT, TRUE, 4, __encoder_cb};
+    UINT_T err[LATENCY_NUM], max_rate[LATENCY_NUM] = {0};
+    INT_T detent[LATENCY_NUM];
+    UCHAR_T i, k;
+
+    sim_bank_drive(TY_GPIO_BANK_B, ENC_AB_MASK, ENC_AB_MASK);
+    if (ENCODER_OK != tuya_encoder_init(&enc)) {
+        printf("encoder init failed\n");
+        return 1;
+    }
+    sim_run_ms(10);
+
+    BENCH_TITLE("encoder step rate sweep, 100 detents, +-50 % step jitter (simulated time)",
+                "steps/s   10us: err  detent   50us: err  detent  200us: err  detent");
+    for (i = 0; i < SIZEOF(sg_step_rate) / SIZEOF(sg_step_rate[0]); i++) {
+        for (k = 0; k < LATENCY_NUM; k++) {
+            err[k] = __rate_run(sg_step_rate[i], sg_latency_us[k], &detent[k]);
+            if ((0 == err[k]) && (DETENT_NUM == detent[k]) && (max_rate[k] == ((i > 0) ? sg_step_rate[i - 1] : 0))) {
+                max_rate[k] = sg_step_rate[i];
+            }
+        }
+        printf("%7u   %9u  %6d   %9u  %6d  %10u  %6d\n", sg_step_rate[i],
+               err[0], detent[0], err[1], detent[1], err[2], detent[2]);
+    }
+    for (k = 0; k < LATENCY_NUM; k++) {
+        printf("latency %3u us: fastest rate without errors %u steps/s\n", sg_latency_us[k], max_rate[k]);
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file bench_gpio_bank.c
+ * @author agent
+ * @brief 8-pin output update, single pin calls against pin handles and bank writes
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "bench.h"
+#include "sim.h"
+#include "sim_reg.h"
+#include "tuya_gpio.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define LED_NUM             8
+#define UPDATE_NUM          1000000
+#define RUN_NUM             5           /* the best of the runs is taken */
+
+/* the led bar takes the bonded out pins of bank B and the first three of bank C */
+#define LED_MASK_B          0xF2
+#define LED_MASK_C          0x07
+
+#define PATH_INPUT          0           /* pattern only, subtracted from the paths */
+#define PATH_WRITE          1
+#define PATH_PIN            2
+#define PATH_BANK           3
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST TY_GPIO_PORT_E sg_led_port[LED_NUM] = {
+    TY_GPIOB_1, TY_GPIOB_4, TY_GPIOB_5, TY_GPIOB_6, TY_GPIOB_7, TY_GPIOC_0, TY_GPIOC_1, TY_GPIOC_2
+};
+STATIC TY_GPIO_PIN_T sg_led_pin[LED_NUM];
+STATIC volatile UCHAR_T sg_pattern_sink = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief led bar pattern of an update, bit n - led n on
+ * @param[in] i: update number
+ * @return pattern
+ */
+STATIC INLINE UCHAR_T __pattern(IN CONST UINT_T i)
+{
+    return (UCHAR_T)(i * 0x9D + (i >> 3));
+}
+
+/**
+ * @brief split the pattern of the led bar into the bank levels
+ * @param[in] pattern: led bar pattern
+ * @param[out] level_b: bank B level
+ * @param[out] level_c: bank C level
+ * @return none
+ */
+STATIC INLINE VOID_T __pattern_split(IN CONST UCHAR_T pattern, OUT UCHAR_T *level_b, OUT UCHAR_T *level_c)
+{
+    /* led 0 - PB1, led 1 to 4 - PB4 to PB7, led 5 to 7 - PC0 to PC2 */
+    *level_b = ((pattern & 0x01) << 1) | ((pattern & 0x1E) << 3);
+    *level_c = (pattern >> 5) & 0x07;
+}
+
+/**
+ * @brief update the led bar UPDATE_NUM times by a path
+ * @param[in] path: PATH_INPUT, PATH_WRITE, PATH_PIN or PATH_BANK
+ * @return host time (ns)
+ */
+STATIC UDLONG_T __path_run_once(IN CONST UCHAR_T path)
+{
+    UDLONG_T start = bench_now_ns();
+    UCHAR_T pattern, level_b, level_c;
+    UINT_T i;
+    UCHAR_T n;
+
+    for (i = 0; i < UPDATE_NUM; i++) {
+        pattern = __pattern(i);
+        switch (path) {
+        case PATH_WRITE:
+            for (n = 0; n < LED_NUM; n++) {
+                tuya_gpio_write(sg_led_port[n], (pattern >> n) & 1);
+            }
+            break;
+        case PATH_PIN:
+            for (n = 0; n < LED_NUM; n++) {
+                tuya_gpio_pin_write(&sg_led_pin[n], (pattern >> n) & 1);
+            }
+            break;
+        case PATH_BANK:
+            __pattern_split(pattern, &level_b, &level_c);
+            tuya_gpio_write_bank(TY_GPIO_BANK_B, LED_MASK_B, level_b);
+            tuya_gpio_write_bank(TY_GPIO_BANK_C, LED_MASK_C, level_c);
+            break;
+        default:
+            sg_pattern_sink = pattern;
+            break;
+        }
+    }
+    return bench_now_ns() - start;
+}
+
+/**
+ * @brief time a path and check the last pattern is on the pins
+ * @param[in] path: PATH_INPUT, PATH_WRITE, PATH_PIN or PATH_BANK
+ * @return the best host time of the runs (ns)
+ */
+STATIC UDLONG_T __path_run(IN CONST UCHAR_T path)
+{
+    UDLONG_T best = 0, ns;
+    UCHAR_T run, level_b, level_c;
+
+    sim_gpio_out[TY_GPIO_BANK_B] = 0;
+    sim_gpio_out[TY_GPIO_BANK_C] = 0;
+    for (run = 0; run < RUN_NUM; run++) {
+        ns = __path_run_once(path);
+        if ((0 == run) || (ns < best)) {
+            best = ns;
+        }
+    }
+    __pattern_split(__pattern(UPDATE_NUM - 1), &level_b, &level_c);
+    if ((path != PATH_INPUT) &&
+        (((sim_gpio_out[TY_GPIO_BANK_B] & LED_MASK_B) != level_b) ||
+         ((sim_gpio_out[TY_GPIO_BANK_C] & LED_MASK_C) != level_c))) {
+        printf("path %u: wrong output\n", path);
+    }
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    UDLONG_T input_ns;
+    UCHAR_T n;
+
+    for (n = 0; n < LED_NUM; n++) {
+        if ((GPIO_OK != tuya_gpio_init(sg_led_port[n], FALSE, FALSE)) ||
+            (GPIO_OK != tuya_gpio_pin_get(sg_led_port[n], &sg_led_pin[n]))) {
+            printf("pin 0x%03x: init failed\n", sg_led_port[n]);
+            return 1;
+        }
+    }
+
+    input_ns = __path_run(PATH_INPUT);
+    BENCH_TITLE("8-pin led bar update over banks B and C (host time)",
+                "path                     ns/update  register writes");
+    printf("8 tuya_gpio_write()       %9.1f  %15u\n", (double)(__path_run(PATH_WRITE) - input_ns) / UPDATE_NUM, LED_NUM);
+    printf("8 tuya_gpio_pin_write()   %9.1f  %15u\n", (double)(__path_run(PATH_PIN) - input_ns) / UPDATE_NUM, LED_NUM);
+    printf("2 tuya_gpio_write_bank()  %9.1f  %15u\n", (double)(__path_run(PATH_BANK) - input_ns) / UPDATE_NUM, 2);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file bench_gpio_dispatch.c
+ * @author agent
+ * @brief gpio interrupt dispatch cost by the number of interrupt pins, the port table
+ *        dispatch against the pin list walk of the first gpio driver
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <stdlib.h>
+#include "bench.h"
+#include "sim.h"
+#include "tuya_gpio.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define PIN_NUM             16      /* all bonded out pins of the chip */
+#define PULSE_NUM           1000
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+/* interrupt pin list of the first gpio driver, walked in each interrupt */
+typedef struct bench_irq_node {
+    TY_GPIO_PORT_E port;
+    BOOL_T level;
+    TY_GPIO_IRQ_CB irq_cb;
+    struct bench_irq_node *next;
+} BENCH_IRQ_NODE_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST TY_GPIO_PORT_E sg_pin[PIN_NUM] = {
+    TY_GPIOB_4, TY_GPIOA_0, TY_GPIOA_1, TY_GPIOB_1, TY_GPIOB_5, TY_GPIOB_6, TY_GPIOB_7, TY_GPIOC_0,
+    TY_GPIOC_1, TY_GPIOC_2, TY_GPIOC_3, TY_GPIOC_4, TY_GPIOD_2, TY_GPIOD_3, TY_GPIOD_4, TY_GPIOD_7
+};
+STATIC CONST UCHAR_T sg_pin_num[] = {1, 8, 16};
+
+STATIC BENCH_IRQ_NODE_T *sg_list_head = NULL;
+STATIC UINT_T sg_cb_cnt = 0;
+STATIC UINT_T sg_list_cb_cnt = 0;
+STATIC UINT_T sg_list_visit_cnt = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __irq_cb(TY_GPIO_PORT_E port)
+{
+    sg_cb_cnt++;
+}
+
+STATIC VOID_T __list_irq_cb(TY_GPIO_PORT_E port)
+{
+    sg_list_cb_cnt++;
+}
+
+/**
+ * @brief add a pin to the list of the first gpio driver
+ * @param[in] port: pin
+ * @return none
+ */
+STATIC VOID_T __list_add(IN CONST TY_GPIO_PORT_E port)
+{
+    BENCH_IRQ_NODE_T *node = (BENCH_IRQ_NODE_T *)malloc(SIZEOF(BENCH_IRQ_NODE_T));
+
+    node->port = port;
+    node->level = tuya_gpio_read(port) ? TRUE : FALSE;
+    node->irq_cb = __list_irq_cb;
+    node->next = sg_list_head;
+    sg_list_head = node;
+}
+
+/**
+ * @brief falling dispatch of the first gpio driver, every pin of the list is read
+ *        to find the one that fired
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __list_dispatch(VOID_T)
+{
+    BENCH_IRQ_NODE_T *node;
+    BOOL_T level;
+
+    for (node = sg_list_head; node != NULL; node = node->next) {
+        sg_list_visit_cnt++;
+        level = tuya_gpio_read(node->port) ? TRUE : FALSE;
+        if (node->level && !level) {
+            node->irq_cb(node->port);
+        }
+        node->level = level;
+    }
+}
+
+/**
+ * @brief pulse the first pin, the list dispatch runs on the interrupts too
+ * @param[in] num: interrupt pins
+ * @return none
+ */
+STATIC VOID_T __dispatch_measure(IN CONST UCHAR_T num)
+{
+    UINT_T irq_start, read_start, table_read = 0, list_read = 0;
+    UINT_T i;
+
+    sg_cb_cnt = 0;
+    sg_list_cb_cnt = 0;
+    sg_list_visit_cnt = 0;
+    irq_start = sim_gpio_irq_cnt();
+    for (i = 0; i < PULSE_NUM; i++) {
+        read_start = sim_gpio_in_read_cnt();
+        sim_pin_set(sg_pin[0], FALSE);
+        table_read += sim_gpio_in_read_cnt() - read_start;
+        read_start = sim_gpio_in_read_cnt();
+        __list_dispatch();
+        list_read += sim_gpio_in_read_cnt() - read_start;
+
+        sim_pin_set(sg_pin[0], TRUE);
+        __list_dispatch();
+        sim_run_us(100);
+    }
+    printf("%4u  %7u  %9.2f  %8.2f  %9.2f  %8.2f  %9.2f\n", num, sim_gpio_irq_cnt() - irq_start,
+           (double)table_read / PULSE_NUM, (double)sg_cb_cnt / PULSE_NUM,
+           (double)list_read / PULSE_NUM, (double)sg_list_visit_cnt / PULSE_NUM / 2,
+           (double)sg_list_cb_cnt / PULSE_NUM);
+}
+
+int main(int argc, char *argv[])
+{
+    UCHAR_T i, num = 0;
+
+    for (i = 0; i < PIN_NUM; i++) {
+        sim_pin_set(sg_pin[i], TRUE);
+    }
+    BENCH_TITLE("gpio falling interrupt dispatch, one pin pulsed 1000 times, per falling edge (simulated)",
+                "pins      irq  table: reads        cb  list: reads    visits         cb");
+    for (i = 0; i < SIZEOF(sg_pin_num); i++) {
+        for (; num < sg_pin_num[i]; num++) {
+            if ((GPIO_OK != tuya_gpio_init(sg_pin[num], TRUE, TRUE)) ||
+                (GPIO_OK != tuya_gpio_irq_init(sg_pin[num], TY_GPIO_IRQ_FALLING, __irq_cb))) {
+                printf("pin 0x%03x: init failed\n", sg_pin[num]);
+                return 1;
+            }
+            __list_add(sg_pin[num]);
+        }
+        __dispatch_measure(num);
+    }
+    printf("the chip has %u bonded out pins, 32 interrupt pins are not possible\n", PIN_NUM);
+    return 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file bench_gpio_storm.c
+ * @author agent
+ * @brief interrupt load of sustained edge storms on one pin, with and without the hold-off
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "tuya_gpio.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define STORM_PORT          TY_GPIOB_4
+#define HOLDOFF_US          2000
+#define LOAD_WINDOW_US      10000   /* interrupt load is counted per window */
+
+#define STORM_KEY           0       /* a key edge each 50 ms, 20 bounces of 50-300 us each */
+#define STORM_SQUARE        1       /* 5 kHz square wave, an edge each 100 us */
+#define STORM_NOISE         2       /* edges at random times of 20-500 us */
+#define STORM_NUM           3
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {
+    UINT_T edge_cnt;            /* edges driven */
+    UINT_T irq_cnt;             /* gpio interrupts */
+    UINT_T cb_cnt;              /* pin callbacks */
+    UINT_T load_max;            /* max interrupts in a load window */
+    BOOL_T level_ok;            /* the last callback saw the final level */
+    TY_GPIO_HOLDOFF_STAT_T stat;
+} STORM_RES_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST CHAR_T *sg_storm_name[STORM_NUM] = {
+    "bouncing key, 2 s", "5 kHz square, 1 s", "random 20-500 us, 1 s"
+};
+
+STATIC STORM_RES_T sg_res;
+STATIC BOOL_T sg_level = TRUE;
+STATIC BOOL_T sg_cb_level = TRUE;
+STATIC UINT_T sg_load_end = 0;
+STATIC UINT_T sg_load_irq = 0;
+STATIC UINT_T sg_seed = 1;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __irq_cb(TY_GPIO_PORT_E port)
+{
+    sg_res.cb_cnt++;
+    sg_cb_level = tuya_gpio_read(port) ? TRUE : FALSE;
+}
+
+/**
+ * @brief storm random numbers, the same sequence in each run
+ * @param[in] min: min value
+ * @param[in] max: max value
+ * @return random value in min - max
+ */
+STATIC UINT_T __rand_range(IN CONST UINT_T min, IN CONST UINT_T max)
+{
+    sg_seed = sg_seed * 1103515245 + 12345;
+    return min + ((sg_seed >> 8) % (max - min + 1));
+}
+
+/**
+ * @brief close the load windows passed
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __load_sample(VOID_T)
+{
+    UINT_T irq;
+
+    while ((INT_T)(sim_time_us() - sg_load_end) >= 0) {
+        irq = sim_gpio_irq_cnt() - sg_load_irq;
+        if (irq > sg_res.load_max) {
+            sg_res.load_max = irq;
+        }
+        sg_load_irq = sim_gpio_irq_cnt();
+        sg_load_end += LOAD_WINDOW_US;
+    }
+}
+
+/**
+ * @brief drive an edge and wait
+ * @param[in] wait_us: time to the next edge
+ * @return none
+ */
+STATIC VOID_T __edge(IN CONST UINT_T wait_us)
+{
+    sg_level = !sg_level;
+    sim_pin_set(STORM_PORT, sg_level);
+    sg_res.edge_cnt++;
+    sim_run_us(wait_us);
+    __load_sample();
+}
+
+/**
+ * @brief run a storm, then let the pin rest
+ * @param[in] storm: storm type
+ * @return none
+ */
+STATIC VOID_T __storm_run(IN CONST UCHAR_T storm)
+{
+    UINT_T end_us, i, press;
+
+    switch (storm) {
+    case STORM_KEY:
+        for (press = 0; press < 40; press++) {
+            for (i = 0; i < 21; i++) {
+                __edge(__rand_range(50, 300));
+            }
+            sim_run_ms(50);
+            __load_sample();
+        }
+        break;
+    case STORM_SQUARE:
+        for (i = 0; i < 10000; i++) {
+            __edge(100);
+        }
+        break;
+    default:
+        end_us = sim_time_us() + 1000000;
+        while ((INT_T)(end_us - sim_time_us()) > 0) {
+            __edge(__rand_range(20, 500));
+        }
+        break;
+    }
+    sim_run_ms(20);
+    __load_sample();
+}
+
+/**
+ * @brief measure a storm with or without the hold-off
+ * @param[in] storm: storm type
+ * @param[in] holdoff: hold-off enabled?
+ * @param[out] res: storm result
+ * @return none
+ */
+STATIC VOID_T __storm_measure(IN CONST UCHAR_T storm, IN CONST BOOL_T holdoff, OUT STORM_RES_T *res)
+{
+    UINT_T irq_start;
+
+    tuya_gpio_irq_set_holdoff(STORM_PORT, holdoff);
+    sim_run_ms(20);
+    tuya_gpio_clr_holdoff_stat();
+    memset(&sg_res, 0, SIZEOF(sg_res));
+    sg_seed = 1;
+    irq_start = sim_gpio_irq_cnt();
+    sg_load_irq = irq_start;
+    sg_load_end = sim_time_us() + LOAD_WINDOW_US;
+
+    __storm_run(storm);
+
+    sg_res.irq_cnt = sim_gpio_irq_cnt() - irq_start;
+    sg_res.level_ok = (sg_cb_level == sg_level);
+    tuya_gpio_get_holdoff_stat(&sg_res.stat);
+    *res = sg_res;
+}
+
+int main(int argc, char *argv[])
+{
+    STORM_RES_T off, on;
+    UCHAR_T storm;
+
+    sim_pin_set(STORM_PORT, TRUE);
+    if ((GPIO_OK != tuya_gpio_init(STORM_PORT, TRUE, TRUE)) ||
+        (GPIO_OK != tuya_gpio_irq_holdoff_init(TY_TIMER_0, HOLDOFF_US)) ||
+        (GPIO_OK != tuya_gpio_irq_init(STORM_PORT, TY_GPIO_IRQ_BOTH, __irq_cb))) {
+        printf("storm pin init failed\n");
+        return 1;
+    }
+
+    BENCH_TITLE("interrupt load of edge storms on one pin, 2 ms hold-off (simulated time)",
+                "storm                   edges  holdoff   irq     cb  max irq/10ms  suppressed  final level");
+    for (storm = 0; storm < STORM_NUM; storm++) {
+        __storm_measure(storm, FALSE, &off);
+        __storm_measure(storm, TRUE, &on);
+        printf("%-22s  %5u  %-7s  %5u  %5u  %12u  %10s  %s\n", sg_storm_name[storm], off.edge_cnt, "off",
+               off.irq_cnt, off.cb_cnt, off.load_max, "-", off.level_ok ? "ok" : "wrong");
+        printf("%-22s  %5s  %-7s  %5u  %5u  %12u  %10u  %s\n", "", "", "on",
+               on.irq_cnt, on.cb_cnt, on.load_max, on.stat.suppress_cnt, on.level_ok ? "ok" : "wrong");
+    }
+    return 0;
+}
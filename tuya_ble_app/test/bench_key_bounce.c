@@ -0,0 +1,240 @@
+/**
+ * @file bench_key_bounce.c
+ * @author agent
+ * @brief press latency against false presses of the debounce algorithms on bounce traces
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "tuya_key.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define BENCH_KEY_NUM       7
+#define PRESS_NUM           50      /* presses or noise spikes of a trace */
+#define HOLD_MS             300
+
+/* all keys see the same trace, on two banks */
+#define TRACE_MASK_B        (TY_GPIO_PORT_TO_MASK(TY_GPIOB_1) | TY_GPIO_PORT_TO_MASK(TY_GPIOB_4) | \
+                             TY_GPIO_PORT_TO_MASK(TY_GPIOB_5) | TY_GPIO_PORT_TO_MASK(TY_GPIOB_6) | \
+                             TY_GPIO_PORT_TO_MASK(TY_GPIOB_7))
+#define TRACE_MASK_C        (TY_GPIO_PORT_TO_MASK(TY_GPIOC_0) | TY_GPIO_PORT_TO_MASK(TY_GPIOC_1))
+
+/* an event callback of each key */
+#define BENCH_KEY_CB(n)     STATIC VOID_T __key_evt_cb_##n(IN CONST KEY_EVENT_T *evt) { __key_evt(n, evt); }
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {
+    CONST CHAR_T *name;
+    TY_GPIO_PORT_E port;
+    KEY_DEBOUNCE_E debounce;
+    UINT_T debounce_ms;
+} BENCH_KEY_T;
+
+typedef struct {
+    CONST CHAR_T *name;
+    UINT_T bounce_us;           /* bounce span of both edges of a press, 0 - noise spikes only */
+    UINT_T spike_min_us;        /* noise spikes of the idle key */
+    UINT_T spike_max_us;
+} BENCH_TRACE_T;
+
+typedef struct {
+    BOOL_T seen;                /* KEY_DOWN of this press seen */
+    UINT_T down_cnt;            /* first KEY_DOWN of a press */
+    UINT_T false_cnt;           /* any other KEY_DOWN */
+    UDLONG_T lat_sum;           /* first edge to KEY_DOWN (us) */
+    UINT_T lat_max;
+} BENCH_RES_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST BENCH_KEY_T sg_bench_key[BENCH_KEY_NUM] = {
+    {"default",         TY_GPIOB_1, KEY_DEBOUNCE_DEFAULT,    0},
+    {"integrator 10ms", TY_GPIOB_4, KEY_DEBOUNCE_INTEGRATOR, 10},
+    {"shift 10ms",      TY_GPIOB_5, KEY_DEBOUNCE_SHIFT,      10},
+    {"lockout 10ms",    TY_GPIOB_6, KEY_DEBOUNCE_LOCKOUT,    10},
+    {"integrator 30ms", TY_GPIOB_7, KEY_DEBOUNCE_INTEGRATOR, 30},
+    {"shift 30ms",      TY_GPIOC_0, KEY_DEBOUNCE_SHIFT,      30},
+    {"lockout 30ms",    TY_GPIOC_1, KEY_DEBOUNCE_LOCKOUT,    30},
+};
+
+STATIC CONST BENCH_TRACE_T sg_bench_trace[] = {
+    {"reed switch, 1 ms bounce",     1000,  0,    0},
+    {"tactile switch, 8 ms bounce",  8000,  0,    0},
+    {"tactile switch, 25 ms bounce", 25000, 0,    0},
+    {"idle key, 1-25 ms noise spikes", 0,   1000, 25000},
+};
+
+STATIC KEY_DEF_T sg_key[BENCH_KEY_NUM];
+STATIC BENCH_RES_T sg_res[BENCH_KEY_NUM];
+STATIC BOOL_T sg_in_press = FALSE;
+STATIC UINT_T sg_press_us = 0;
+STATIC UINT_T sg_seed = 1;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief record the KEY_DOWN of a key
+ * @param[in] n: bench key
+ * @param[in] evt: key event
+ * @return none
+ */
+STATIC VOID_T __key_evt(IN CONST UCHAR_T n, IN CONST KEY_EVENT_T *evt)
+{
+    BENCH_RES_T *res = &sg_res[n];
+    UINT_T lat;
+
+    if (evt->type != KEY_DOWN) {
+        return;
+    }
+    if (!sg_in_press || res->seen) {
+        res->false_cnt++;
+        return;
+    }
+    res->seen = TRUE;
+    res->down_cnt++;
+    lat = sim_time_us() - sg_press_us;
+    res->lat_sum += lat;
+    if (lat > res->lat_max) {
+        res->lat_max = lat;
+    }
+}
+
+BENCH_KEY_CB(0)
+BENCH_KEY_CB(1)
+BENCH_KEY_CB(2)
+BENCH_KEY_CB(3)
+BENCH_KEY_CB(4)
+BENCH_KEY_CB(5)
+BENCH_KEY_CB(6)
+
+/**
+ * @brief trace random numbers, the same sequence in each run
+ * @param[in] min: min value
+ * @param[in] max: max value
+ * @return random value in min - max
+ */
+STATIC UINT_T __rand_range(IN CONST UINT_T min, IN CONST UINT_T max)
+{
+    sg_seed = sg_seed * 1103515245 + 12345;
+    return min + ((sg_seed >> 8) % (max - min + 1));
+}
+
+/**
+ * @brief drive the trace level on all keys for a time
+ * @param[in] pressed: the keys are pressed?
+ * @param[in] time_us: time
+ * @return none
+ */
+STATIC VOID_T __trace_drive(IN CONST BOOL_T pressed, IN CONST UINT_T time_us)
+{
+    sim_bank_drive(TY_GPIO_BANK_B, TRACE_MASK_B, pressed ? 0x00 : 0xFF);
+    sim_bank_drive(TY_GPIO_BANK_C, TRACE_MASK_C, pressed ? 0x00 : 0xFF);
+    sim_run_us(time_us);
+}
+
+/**
+ * @brief a contact edge, the contact bounces for the span and then rests at the level
+ * @param[in] pressed: final level
+ * @param[in] bounce_us: bounce span
+ * @return none
+ */
+STATIC VOID_T __trace_edge(IN CONST BOOL_T pressed, IN CONST UINT_T bounce_us)
+{
+    UINT_T t = 0, seg;
+    BOOL_T level = pressed;
+
+    while (t < bounce_us) {
+        seg = __rand_range(100, 2000);
+        __trace_drive(level, seg);
+        level = !level;
+        t += seg;
+    }
+    __trace_drive(pressed, 0);
+}
+
+/**
+ * @brief run a trace on all keys, the random idle times move it against the scan ticks
+ * @param[in] trace: trace
+ * @return none
+ */
+STATIC VOID_T __trace_run(IN CONST BENCH_TRACE_T *trace)
+{
+    UCHAR_T i, n;
+
+    memset(sg_res, 0, SIZEOF(sg_res));
+    sg_seed = 1;
+    for (i = 0; i < PRESS_NUM; i++) {
+        if (0 == trace->bounce_us) {
+            __trace_drive(FALSE, __rand_range(200000, 300000));
+            __trace_drive(TRUE, __rand_range(trace->spike_min_us, trace->spike_max_us));
+            __trace_drive(FALSE, __rand_range(200000, 300000));
+            continue;
+        }
+        __trace_drive(FALSE, __rand_range(300000, 500000));
+        for (n = 0; n < BENCH_KEY_NUM; n++) {
+            sg_res[n].seen = FALSE;
+        }
+        sg_in_press = TRUE;
+        sg_press_us = sim_time_us();
+        __trace_edge(TRUE, trace->bounce_us);
+        sim_run_ms(HOLD_MS);
+        __trace_edge(FALSE, trace->bounce_us);
+        sim_run_ms(100);
+        sg_in_press = FALSE;
+    }
+    sim_run_ms(500);
+}
+
+int main(int argc, char *argv[])
+{
+    STATIC CONST KEY_EVENT_CALLBACK evt_cb[BENCH_KEY_NUM] = {
+        __key_evt_cb_0, __key_evt_cb_1, __key_evt_cb_2, __key_evt_cb_3, __key_evt_cb_4, __key_evt_cb_5, __key_evt_cb_6
+    };
+    CONST BENCH_RES_T *res;
+    UCHAR_T i, n;
+
+    tuya_software_timer_init();
+    sim_set_loop(tuya_key_loop);
+    __trace_drive(FALSE, 0);
+    for (n = 0; n < BENCH_KEY_NUM; n++) {
+        memset(&sg_key[n], 0, SIZEOF(KEY_DEF_T));
+        sg_key[n].port = sg_bench_key[n].port;
+        sg_key[n].active_low = TRUE;
+        sg_key[n].evt_cb = evt_cb[n];
+        sg_key[n].debounce = sg_bench_key[n].debounce;
+        sg_key[n].debounce_ms = sg_bench_key[n].debounce_ms;
+        if (KEY_OK != tuya_reg_key(&sg_key[n])) {
+            printf("%s: register failed\n", sg_bench_key[n].name);
+            return 1;
+        }
+    }
+    sim_run_ms(500);
+
+    for (i = 0; i < SIZEOF(sg_bench_trace) / SIZEOF(sg_bench_trace[0]); i++) {
+        __trace_run(&sg_bench_trace[i]);
+        BENCH_TITLE(sg_bench_trace[i].name, "algorithm         presses  missed  false  lat avg(ms)  lat max(ms)");
+        for (n = 0; n < BENCH_KEY_NUM; n++) {
+            res = &sg_res[n];
+            if (0 == sg_bench_trace[i].bounce_us) {
+                printf("%-16s  %7s  %6s  %5u  %11s  %11s\n", sg_bench_key[n].name, "-", "-", res->false_cnt, "-", "-");
+                continue;
+            }
+            printf("%-16s  %7u  %6u  %5u  %11.1f  %11.1f\n", sg_bench_key[n].name, res->down_cnt,
+                   PRESS_NUM - res->down_cnt, res->false_cnt,
+                   res->down_cnt ? (double)res->lat_sum / res->down_cnt / 1000 : 0.0, (double)res->lat_max / 1000);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**
+ * @file bench_key_debounce.c
+ * @author agent
+ * @brief scan tick cost of the per-key path of the first key driver against
+ *        the bank vertical counters, for key counts up to 128
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "bench.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_NUM_MAX         128
+#define BANK_BITS           32          /* key source banks are 32 keys wide, gpio banks 8 */
+#define BANK_NUM_MAX        (KEY_NUM_MAX / BANK_BITS)
+#define TICK_NUM            200000
+#define SCAN_CYCLE_MS       10
+#define PRESS_SHORT_MS      50
+#define PRESS_TICKS         20          /* each key in turn is pressed for 200 ms */
+#define PRESS_PERIOD        50          /* one press every 500 ms */
+
+#define PATH_INPUT          0           /* input trace only, subtracted from the paths */
+#define PATH_OLD            1
+#define PATH_BANK           2
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+/* per-key status of the first key driver */
+typedef struct {
+    BOOL_T cur_stat;
+    BOOL_T prv_stat;
+    UINT_T cur_time;
+    UINT_T prv_time;
+} OLD_KEY_STATUS_T;
+
+/* bank of the vertical counter path */
+typedef struct {
+    UINT_T state;
+    UINT_T cnt0;
+    UINT_T cnt1;
+} BANK_T;
+
+/* per-key status of the vertical counter path, touched only for active keys */
+typedef struct {
+    BOOL_T cur_stat;
+    BOOL_T fired;
+    UINT_T press_tick;
+} NEW_KEY_STATUS_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC volatile UINT_T sg_in[BANK_NUM_MAX];        /* raw input words, bit set - pressed */
+STATIC UCHAR_T sg_port_bank[KEY_NUM_MAX];          /* port table, as tuya_gpio_read() looks up the pin */
+STATIC UINT_T sg_port_mask[KEY_NUM_MAX];
+STATIC OLD_KEY_STATUS_T sg_old_stat[KEY_NUM_MAX];
+STATIC BANK_T sg_bank[BANK_NUM_MAX];
+STATIC NEW_KEY_STATUS_T sg_new_stat[KEY_NUM_MAX];
+STATIC UINT_T sg_read_cnt = 0;
+STATIC UINT_T sg_event_cnt = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief read one pin, a register read behind a port table lookup
+ * @param[in] port: key number
+ * @return TRUE - pressed
+ */
+STATIC __attribute__((noinline)) BOOL_T __pin_read(IN CONST UCHAR_T port)
+{
+    sg_read_cnt++;
+    return (sg_in[sg_port_bank[port]] & sg_port_mask[port]) ? TRUE : FALSE;
+}
+
+/**
+ * @brief read all pins of a bank, one register read
+ * @param[in] bank: bank
+ * @return pressed bits
+ */
+STATIC __attribute__((noinline)) UINT_T __bank_read(IN CONST UCHAR_T bank)
+{
+    sg_read_cnt++;
+    return sg_in[bank];
+}
+
+/**
+ * @brief scan tick of the first key driver: every key is read and checked every tick
+ * @param[in] key_num: number of keys
+ * @return none
+ */
+STATIC VOID_T __old_tick(IN CONST UCHAR_T key_num)
+{
+    OLD_KEY_STATUS_T *s;
+    BOOL_T key_stat;
+    UCHAR_T i;
+
+    for (i = 0; i < key_num; i++) {
+        s = &sg_old_stat[i];
+        s->prv_stat = s->cur_stat;
+        s->prv_time = s->cur_time;
+        key_stat = __pin_read(i);
+        if (key_stat != s->cur_stat) {
+            s->cur_stat = key_stat;
+            s->cur_time = 0;
+        } else {
+            s->cur_time += SCAN_CYCLE_MS;
+        }
+        /* no long press: short press at the min press time */
+        if (s->cur_stat && (s->cur_time >= PRESS_SHORT_MS) && (s->prv_time < PRESS_SHORT_MS)) {
+            sg_event_cnt++;
+        }
+    }
+}
+
+/**
+ * @brief scan tick of the bank path: one read and one vertical counter update per bank,
+ *        only pressed or toggled keys are handled
+ * @param[in] key_num: number of keys
+ * @param[in] tick: tick number
+ * @return none
+ */
+STATIC VOID_T __new_tick(IN CONST UCHAR_T key_num, IN CONST UINT_T tick)
+{
+    UCHAR_T bank, bank_num = (key_num + BANK_BITS - 1) / BANK_BITS;
+    UINT_T sample, delta, toggle, active, key_mask;
+    NEW_KEY_STATUS_T *s;
+    BANK_T *b;
+    UCHAR_T bit;
+
+    for (bank = 0; bank < bank_num; bank++) {
+        b = &sg_bank[bank];
+        key_mask = ((key_num - bank * BANK_BITS) >= BANK_BITS) ? 0xFFFFFFFF : ((1u << (key_num - bank * BANK_BITS)) - 1);
+        sample = __bank_read(bank) & key_mask;
+        delta = sample ^ b->state;
+        toggle = delta & b->cnt0 & b->cnt1;
+        b->cnt1 = (b->cnt1 ^ b->cnt0) & delta;
+        b->cnt0 = ~b->cnt0 & delta;
+        b->state ^= toggle;
+        active = toggle | b->state;
+        while (active) {
+            bit = __builtin_ctz(active);
+            active &= active - 1;
+            s = &sg_new_stat[bank * BANK_BITS + bit];
+            if (!((b->state >> bit) & 0x01)) {
+                s->cur_stat = FALSE;
+                continue;
+            }
+            if (!s->cur_stat) {
+                s->cur_stat = TRUE;
+                s->fired = FALSE;
+                s->press_tick = tick;
+            }
+            if (!s->fired && ((tick - s->press_tick) * SCAN_CYCLE_MS >= PRESS_SHORT_MS)) {
+                s->fired = TRUE;
+                sg_event_cnt++;
+            }
+        }
+    }
+}
+
+/**
+ * @brief set the inputs of a tick: the keys are pressed in turn
+ * @param[in] key_num: number of keys
+ * @param[in] tick: tick number
+ * @return none
+ */
+STATIC VOID_T __input_set(IN CONST UCHAR_T key_num, IN CONST UINT_T tick)
+{
+    UCHAR_T key = (tick / PRESS_PERIOD) % key_num;
+    UCHAR_T bank;
+
+    for (bank = 0; bank < BANK_NUM_MAX; bank++) {
+        sg_in[bank] = 0;
+    }
+    if ((tick % PRESS_PERIOD) < PRESS_TICKS) {
+        sg_in[key / BANK_BITS] = 1u << (key % BANK_BITS);
+    }
+}
+
+/**
+ * @brief run the ticks of one path
+ * @param[in] key_num: number of keys
+ * @param[in] path: PATH_INPUT, PATH_OLD or PATH_BANK
+ * @param[out] reads: register reads per tick
+ * @param[out] events: short presses detected
+ * @return host time of all ticks (ns)
+ */
+STATIC UDLONG_T __path_run(IN CONST UCHAR_T key_num, IN CONST UCHAR_T path, OUT UINT_T *reads, OUT UINT_T *events)
+{
+    UDLONG_T start;
+    UINT_T tick;
+
+    memset(sg_old_stat, 0, SIZEOF(sg_old_stat));
+    memset(sg_new_stat, 0, SIZEOF(sg_new_stat));
+    memset(sg_bank, 0, SIZEOF(sg_bank));
+    sg_read_cnt = 0;
+    sg_event_cnt = 0;
+    start = bench_now_ns();
+    for (tick = 0; tick < TICK_NUM; tick++) {
+        __input_set(key_num, tick);
+        if (PATH_BANK == path) {
+            __new_tick(key_num, tick);
+        } else if (PATH_OLD == path) {
+            __old_tick(key_num);
+        }
+    }
+    start = bench_now_ns() - start;
+    *reads = sg_read_cnt / TICK_NUM;
+    *events = sg_event_cnt;
+    return start;
+}
+
+int main(int argc, char *argv[])
+{
+    STATIC CONST UCHAR_T key_num[] = {2, 8, 32, 128};
+    UDLONG_T input_ns, old_ns, new_ns;
+    UINT_T old_reads, new_reads, old_events, new_events;
+    UCHAR_T i, k;
+
+    for (k = 0; k < KEY_NUM_MAX; k++) {
+        sg_port_bank[k] = k / BANK_BITS;
+        sg_port_mask[k] = 1u << (k % BANK_BITS);
+    }
+
+    BENCH_TITLE("scan tick cost, per-key path against bank vertical counters (host time, one key pressed at a time)",
+                "keys  reads/tick old  new  ns/tick old    new  presses old    new");
+    for (i = 0; i < SIZEOF(key_num); i++) {
+        input_ns = __path_run(key_num[i], PATH_INPUT, &old_reads, &old_events);
+        old_ns = __path_run(key_num[i], PATH_OLD, &old_reads, &old_events) - input_ns;
+        new_ns = __path_run(key_num[i], PATH_BANK, &new_reads, &new_events) - input_ns;
+        printf("%4u  %14u  %3u  %11.1f  %5.1f  %11u  %5u\n", key_num[i], old_reads, new_reads,
+               (double)old_ns / TICK_NUM, (double)new_ns / TICK_NUM, old_events, new_events);
+    }
+    return 0;
+}
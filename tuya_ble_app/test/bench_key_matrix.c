@@ -0,0 +1,126 @@
+/**
+ * @file bench_key_matrix.c
+ * @author agent
+ * @brief scan time per full sweep of a 4x4 matrix keypad
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "sim_reg.h"
+#include "tuya_key.h"
+#include "tuya_key_matrix.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define ROW_NUM             4
+#define COL_NUM             4
+#define SWEEP_NUM           1000
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC CONST TY_GPIO_PORT_E sg_row_port[ROW_NUM] = {TY_GPIOB_4, TY_GPIOB_5, TY_GPIOB_6, TY_GPIOB_7};
+STATIC CONST TY_GPIO_PORT_E sg_col_port[COL_NUM] = {TY_GPIOC_0, TY_GPIOC_1, TY_GPIOC_2, TY_GPIOC_3};
+STATIC CONST KEY_MATRIX_DEF_T sg_matrix = {sg_row_port, ROW_NUM, sg_col_port, COL_NUM};
+
+STATIC BOOL_T sg_key_down[ROW_NUM][COL_NUM];    /* board: pressed keys */
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief board model without diodes: a pressed key joins its row and column, so a low row
+ *        pulls the columns and rows joined to it through the pressed keys
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __board_update(VOID_T)
+{
+    UCHAR_T row, col, mask = 0, level = 0xFF;
+    UCHAR_T row_low = 0, col_low = 0, prv_row, prv_col;
+
+    for (row = 0; row < ROW_NUM; row++) {
+        if (!sim_pin_get_out(sg_row_port[row])) {
+            row_low |= (1 << row);
+        }
+    }
+    do {
+        prv_row = row_low;
+        prv_col = col_low;
+        for (row = 0; row < ROW_NUM; row++) {
+            for (col = 0; col < COL_NUM; col++) {
+                if (!sg_key_down[row][col]) {
+                    continue;
+                }
+                if (row_low & (1 << row)) {
+                    col_low |= (1 << col);
+                }
+                if (col_low & (1 << col)) {
+                    row_low |= (1 << row);
+                }
+            }
+        }
+    } while ((row_low != prv_row) || (col_low != prv_col));
+
+    for (col = 0; col < COL_NUM; col++) {
+        mask |= TY_GPIO_PORT_TO_MASK(sg_col_port[col]);
+        if (col_low & (1 << col)) {
+            level &= ~TY_GPIO_PORT_TO_MASK(sg_col_port[col]);
+        }
+    }
+    sim_bank_drive(TY_GPIO_BANK_C, mask, level);
+}
+
+/**
+ * @brief sweep the matrix with some keys held and print the sweep time
+ * @param[in] name: case name
+ * @param[in] key: held keys, bit KEY_MATRIX_BIT(row, col, COL_NUM)
+ * @return none
+ */
+STATIC VOID_T __sweep_measure(IN CONST CHAR_T *name, IN CONST UINT_T key)
+{
+    KEY_MATRIX_STAT_T stat;
+    UINT_T state = 0;
+    UINT_T i;
+
+    for (i = 0; i < ROW_NUM * COL_NUM; i++) {
+        sg_key_down[i / COL_NUM][i % COL_NUM] = (key & (1u << i)) ? TRUE : FALSE;
+    }
+    tuya_key_matrix_clr_stat();
+    for (i = 0; i < SWEEP_NUM; i++) {
+        state = tuya_key_matrix_read();
+    }
+    tuya_key_matrix_get_stat(&stat);
+    printf("%-16s  %8.2f  %7.2f  %5u  0x%04x\n", name, (double)stat.sweep_cost_last / CLOCK_SYS_CLOCK_1US,
+           (double)stat.sweep_cost_max / CLOCK_SYS_CLOCK_1US, stat.ghost_cnt, state);
+}
+
+int main(int argc, char *argv[])
+{
+    sim_set_board(__board_update);
+    if (KEY_OK != tuya_key_matrix_init(&sg_matrix)) {
+        printf("matrix init failed\n");
+        return 1;
+    }
+
+    BENCH_TITLE("4x4 matrix sweep time, 1000 sweeps a case (simulated clock, 16 ticks/us)",
+                "keys held         last(us)  max(us)  ghost  state");
+    __sweep_measure("none", 0);
+    __sweep_measure("one", 1u << KEY_MATRIX_BIT(1, 2, COL_NUM));
+    __sweep_measure("two in a row", (1u << KEY_MATRIX_BIT(0, 0, COL_NUM)) | (1u << KEY_MATRIX_BIT(0, 3, COL_NUM)));
+    __sweep_measure("three, ghost", (1u << KEY_MATRIX_BIT(0, 0, COL_NUM)) | (1u << KEY_MATRIX_BIT(0, 1, COL_NUM)) |
+                    (1u << KEY_MATRIX_BIT(1, 0, COL_NUM)));
+    printf("a sweep waits %u column settles of 2 us, the rest are the clock reads\n", ROW_NUM + 1);
+    return 0;
+}
@@ -0,0 +1,270 @@
+/**
+ * @file bench_key_plan.c
+ * @author agent
+ * @brief scan tick cost of the threshold checks, recomputed from the key define in each
+ *        tick as the first key driver did against the plan precomputed at registration
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "bench.h"
+#include "tuya_key.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_NUM             8
+#define TICK_NUM            1000000
+#define SCAN_CYCLE_MS       10
+#define PRESS_SHORT_MS      50
+#define TIME_NEVER          0xFFFFFFFF
+
+#define PATH_INPUT          0           /* input trace only, subtracted from the paths */
+#define PATH_OLD            1
+#define PATH_PLAN           2
+#define RUN_NUM             5           /* the best of the runs is taken */
+
+/* a threshold compare, counted in the counting runs */
+#define CMP(c)              (sg_cmp_cnt += sg_cmp_on, (c))
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {
+    BOOL_T cur_stat;
+    BOOL_T prv_stat;
+    UINT_T cur_time;
+    UINT_T prv_time;
+} KEY_STATUS_T;
+
+/* precomputed at registration: thresholds in ascending order with their event types */
+typedef struct {
+    UINT_T level_time[2];
+    KEY_PRESS_TYPE_E level_type[2];
+    UCHAR_T level_num;
+} KEY_PLAN_T;
+
+typedef struct {
+    UCHAR_T level_idx;
+    UINT_T next_time;
+} KEY_PLAN_STATUS_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC KEY_DEF_T sg_key_def[KEY_NUM];
+STATIC KEY_STATUS_T sg_key_stat[KEY_NUM];
+STATIC KEY_PLAN_T sg_key_plan[KEY_NUM];
+STATIC KEY_PLAN_STATUS_T sg_plan_stat[KEY_NUM];
+STATIC volatile BOOL_T sg_in[KEY_NUM];
+STATIC UINT_T sg_event_cnt[4];
+STATIC volatile UINT_T sg_cmp_on = 0;
+STATIC UDLONG_T sg_cmp_cnt = 0;  /* SHORT_PRESS, LONG_PRESS_FOR_TIME1, LONG_PRESS_FOR_TIME2, other */
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __event(IN CONST KEY_PRESS_TYPE_E type)
+{
+    sg_event_cnt[(type <= LONG_PRESS_FOR_TIME2) ? type : 3]++;
+}
+
+/**
+ * @brief status update shared by both paths
+ * @param[in] i: key
+ * @return none
+ */
+STATIC VOID_T __status_update(IN CONST UCHAR_T i)
+{
+    KEY_STATUS_T *s = &sg_key_stat[i];
+
+    s->prv_stat = s->cur_stat;
+    s->prv_time = s->cur_time;
+    if (sg_in[i] != s->cur_stat) {
+        s->cur_stat = sg_in[i];
+        s->cur_time = 0;
+    } else {
+        s->cur_time += SCAN_CYCLE_MS;
+    }
+}
+
+/**
+ * @brief threshold checks of the first key driver, the times are sorted in each tick
+ * @param[in] i: key
+ * @return none
+ */
+STATIC __attribute__((noinline)) VOID_T __old_detect(IN CONST UCHAR_T i)
+{
+    CONST KEY_DEF_T *def = &sg_key_def[i];
+    CONST KEY_STATUS_T *s = &sg_key_stat[i];
+    KEY_PRESS_TYPE_E type;
+    BOOL_T time_exchange;
+    UINT_T long_time1, long_time2;
+
+    if (CMP(def->long_press_time2 >= def->long_press_time1)) {
+        long_time1 = def->long_press_time1;
+        long_time2 = def->long_press_time2;
+        time_exchange = FALSE;
+    } else {
+        long_time1 = def->long_press_time2;
+        long_time2 = def->long_press_time1;
+        time_exchange = TRUE;
+    }
+    if (s->cur_stat && CMP(s->cur_time >= long_time2) && CMP(s->prv_time < long_time2)) {
+        type = LONG_PRESS_FOR_TIME2;
+    } else if (s->prv_stat && !s->cur_stat && CMP(s->prv_time >= long_time1) && CMP(s->prv_time < long_time2)) {
+        type = LONG_PRESS_FOR_TIME1;
+    } else if (s->prv_stat && !s->cur_stat && CMP(s->prv_time >= PRESS_SHORT_MS) && CMP(s->prv_time < long_time1)) {
+        type = SHORT_PRESS;
+    } else {
+        return;
+    }
+    if (time_exchange && (type != SHORT_PRESS)) {
+        type = (LONG_PRESS_FOR_TIME2 == type) ? LONG_PRESS_FOR_TIME1 : LONG_PRESS_FOR_TIME2;
+    }
+    __event(type);
+}
+
+/**
+ * @brief threshold checks against the plan, one compare while held
+ * @param[in] i: key
+ * @return none
+ */
+STATIC __attribute__((noinline)) VOID_T __plan_detect(IN CONST UCHAR_T i)
+{
+    CONST KEY_PLAN_T *plan = &sg_key_plan[i];
+    KEY_PLAN_STATUS_T *p = &sg_plan_stat[i];
+    CONST KEY_STATUS_T *s = &sg_key_stat[i];
+
+    if (s->cur_stat) {
+        if (!s->prv_stat) {
+            p->level_idx = 0;
+            p->next_time = plan->level_time[0];
+        }
+        while (CMP(s->cur_time >= p->next_time)) {
+            p->level_idx++;
+            if (p->level_idx < plan->level_num) {
+                p->next_time = plan->level_time[p->level_idx];
+            } else {
+                p->next_time = TIME_NEVER;
+                __event(plan->level_type[plan->level_num - 1]);
+            }
+        }
+        return;
+    }
+    if (!s->prv_stat || (p->level_idx >= plan->level_num)) {
+        return;
+    }
+    if (p->level_idx > 0) {
+        __event(plan->level_type[p->level_idx - 1]);
+    } else if (CMP(s->prv_time >= PRESS_SHORT_MS)) {
+        __event(SHORT_PRESS);
+    }
+}
+
+/**
+ * @brief precompute the plan of a key, done once at registration
+ * @param[in] i: key
+ * @return none
+ */
+STATIC VOID_T __plan_init(IN CONST UCHAR_T i)
+{
+    CONST KEY_DEF_T *def = &sg_key_def[i];
+    KEY_PLAN_T *plan = &sg_key_plan[i];
+    BOOL_T swap = (def->long_press_time1 > def->long_press_time2);
+
+    plan->level_time[0] = swap ? def->long_press_time2 : def->long_press_time1;
+    plan->level_time[1] = swap ? def->long_press_time1 : def->long_press_time2;
+    plan->level_type[0] = swap ? LONG_PRESS_FOR_TIME2 : LONG_PRESS_FOR_TIME1;
+    plan->level_type[1] = swap ? LONG_PRESS_FOR_TIME1 : LONG_PRESS_FOR_TIME2;
+    plan->level_num = 2;
+}
+
+/**
+ * @brief run the ticks of one path, the keys are held for a growing time in turn
+ * @param[in] path: PATH_INPUT, PATH_OLD or PATH_PLAN
+ * @return host time of all ticks (ns)
+ */
+STATIC UDLONG_T __path_run_once(IN CONST UCHAR_T path)
+{
+    UDLONG_T start;
+    UINT_T tick, phase;
+    UCHAR_T i, key;
+
+    memset(sg_key_stat, 0, SIZEOF(sg_key_stat));
+    memset(sg_plan_stat, 0, SIZEOF(sg_plan_stat));
+    memset(sg_event_cnt, 0, SIZEOF(sg_event_cnt));
+    start = bench_now_ns();
+    for (tick = 0; tick < TICK_NUM; tick++) {
+        /* a press of 3 to 460 ticks every 500 ticks, on the keys in turn */
+        key = (tick / 500) % KEY_NUM;
+        phase = tick % 500;
+        sg_in[(key + KEY_NUM - 1) % KEY_NUM] = FALSE;
+        sg_in[key] = (phase < 3 + ((tick / 500) * 37) % 458) ? TRUE : FALSE;
+        for (i = 0; i < KEY_NUM; i++) {
+            __status_update(i);
+            if (PATH_OLD == path) {
+                __old_detect(i);
+            } else if (PATH_PLAN == path) {
+                __plan_detect(i);
+            }
+        }
+    }
+    return bench_now_ns() - start;
+}
+
+/**
+ * @brief time a path, then count its compares in one more run
+ * @param[in] path: PATH_INPUT, PATH_OLD or PATH_PLAN
+ * @return the best host time of the runs (ns)
+ */
+STATIC UDLONG_T __path_run(IN CONST UCHAR_T path)
+{
+    UDLONG_T best = 0, ns;
+    UCHAR_T run;
+
+    for (run = 0; run < RUN_NUM; run++) {
+        ns = __path_run_once(path);
+        if ((0 == run) || (ns < best)) {
+            best = ns;
+        }
+    }
+    sg_cmp_cnt = 0;
+    sg_cmp_on = 1;
+    __path_run_once(path);
+    sg_cmp_on = 0;
+    return best;
+}
+
+int main(int argc, char *argv[])
+{
+    UDLONG_T input_ns, old_ns, plan_ns;
+    UINT_T old_cnt[4];
+    UDLONG_T old_cmp;
+    UCHAR_T i;
+
+    for (i = 0; i < KEY_NUM; i++) {
+        /* half of the keys with the times given in the reverse order */
+        sg_key_def[i].long_press_time1 = (i & 1) ? 3000 : 1000;
+        sg_key_def[i].long_press_time2 = (i & 1) ? 1000 : 3000;
+        __plan_init(i);
+    }
+
+    input_ns = __path_run(PATH_INPUT);
+    old_ns = __path_run(PATH_OLD) - input_ns;
+    memcpy(old_cnt, sg_event_cnt, SIZEOF(old_cnt));
+    old_cmp = sg_cmp_cnt;
+    plan_ns = __path_run(PATH_PLAN) - input_ns;
+
+    BENCH_TITLE("threshold checks per scan tick, 8 keys with two long press times",
+                "path                cmp/key/tick  ns/tick  short  long1  long2");
+    printf("per tick recompute  %12.2f  %7.1f  %5u  %5u  %5u\n", (double)old_cmp / TICK_NUM / KEY_NUM,
+           (double)old_ns / TICK_NUM, old_cnt[0], old_cnt[1], old_cnt[2]);
+    printf("precomputed plan    %12.2f  %7.1f  %5u  %5u  %5u\n", (double)sg_cmp_cnt / TICK_NUM / KEY_NUM,
+           (double)plan_ns / TICK_NUM, sg_event_cnt[0], sg_event_cnt[1], sg_event_cnt[2]);
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ * @file bench_key_wakeup.c
+ * @author agent
+ * @brief key scan wakeups per hour, poll against edge scan mode
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "bench.h"
+#include "sim.h"
+#include "tuya_key.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_PORT            TY_GPIOB_4
+#define IDLE_MS             60000   /* idle time measured, scaled to an hour */
+#define PRESS_NUM           20      /* presses measured, scaled to the press rate */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {
+    UINT_T idle_scan;           /* scan ticks in IDLE_MS */
+    UINT_T press_scan;          /* scan ticks of PRESS_NUM presses */
+    UINT_T press_wakeup;        /* edge interrupts of PRESS_NUM presses */
+} WAKEUP_RES_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+STATIC KEY_DEF_T sg_key;
+STATIC UINT_T sg_short_cnt = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __key_cb(KEY_PRESS_TYPE_E type)
+{
+    if (SHORT_PRESS == type) {
+        sg_short_cnt++;
+    }
+}
+
+/**
+ * @brief measure the scan ticks of one key idle and pressed in a scan mode
+ * @param[in] mode: scan mode
+ * @param[out] res: scan ticks and wakeups
+ * @return none
+ */
+STATIC VOID_T __wakeup_measure(IN CONST KEY_SCAN_MODE_E mode, OUT WAKEUP_RES_T *res)
+{
+    KEY_SCAN_STAT_T stat;
+    KEY_HANDLE handle;
+    UCHAR_T i;
+
+    tuya_key_set_scan_mode(mode);
+    memset(&sg_key, 0, SIZEOF(KEY_DEF_T));
+    sg_key.port = KEY_PORT;
+    sg_key.active_low = TRUE;
+    sg_key.key_cb = __key_cb;
+    sim_pin_set(KEY_PORT, TRUE);
+    tuya_reg_key(&sg_key);
+    sim_run_ms(500);
+
+    tuya_key_clr_scan_stat();
+    sim_run_ms(IDLE_MS);
+    tuya_key_get_scan_stat(&stat);
+    res->idle_scan = stat.scan_cnt;
+
+    /* 150 ms presses, 1 s apart, less the idle ticks of that time */
+    sg_short_cnt = 0;
+    tuya_key_clr_scan_stat();
+    for (i = 0; i < PRESS_NUM; i++) {
+        sim_pin_set(KEY_PORT, FALSE);
+        sim_run_ms(150);
+        sim_pin_set(KEY_PORT, TRUE);
+        sim_run_ms(850);
+    }
+    tuya_key_get_scan_stat(&stat);
+    res->press_scan = stat.scan_cnt - (UINT_T)((UDLONG_T)res->idle_scan * PRESS_NUM * 1000 / IDLE_MS);
+    res->press_wakeup = stat.wakeup_cnt;
+    if (sg_short_cnt != PRESS_NUM) {
+        printf("mode %u: %u of %u presses seen\n", mode, sg_short_cnt, PRESS_NUM);
+    }
+
+    tuya_key_get_handle(&sg_key, &handle);
+    tuya_unreg_key(handle);
+    sim_run_ms(500);
+}
+
+int main(int argc, char *argv[])
+{
+    STATIC CONST UINT_T press_rate[] = {0, 10, 60, 600, 3600};
+    WAKEUP_RES_T poll, edge;
+    UDLONG_T poll_h, edge_h;
+    UCHAR_T i;
+
+    tuya_software_timer_init();
+    sim_set_loop(tuya_key_loop);
+    __wakeup_measure(KEY_SCAN_MODE_POLL, &poll);
+    __wakeup_measure(KEY_SCAN_MODE_EDGE, &edge);
+
+    BENCH_TITLE("key scan wakeups per hour, one key, 150 ms presses (simulated time)",
+                "presses/h  poll ticks/h  edge ticks/h  edge irq/h");
+    for (i = 0; i < SIZEOF(press_rate) / SIZEOF(press_rate[0]); i++) {
+        poll_h = (UDLONG_T)poll.idle_scan * 3600000 / IDLE_MS + (UDLONG_T)poll.press_scan * press_rate[i] / PRESS_NUM;
+        edge_h = (UDLONG_T)edge.idle_scan * 3600000 / IDLE_MS + (UDLONG_T)edge.press_scan * press_rate[i] / PRESS_NUM;
+        printf("%9u  %12llu  %12llu  %10u\n", press_rate[i], poll_h, edge_h,
+               edge.press_wakeup * press_rate[i] / PRESS_NUM);
+    }
+    printf("edge mode per press: %u scan ticks, %u edge interrupts, idle: %u scan ticks\n",
+           edge.press_scan / PRESS_NUM, edge.press_wakeup / PRESS_NUM, edge.idle_scan);
+    return 0;
+}
@@ -0,0 +1,22 @@
+/**
+ * @file adc.h
+ * @author agent
+ * @brief host simulation of the TLSR825x adc driver
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_ADC_H__
+#define __SIM_ADC_H__
+
+#include "gpio_8258.h"
+
+void adc_init(void);
+void adc_base_init(GPIO_PinTypeDef pin);
+void adc_power_on_sar_adc(unsigned char on_off);
+unsigned int adc_sample_and_get_result(void);
+
+#endif /* __SIM_ADC_H__ */
@@ -0,0 +1,22 @@
+/**
+ * @file blt_soft_timer.h
+ * @author agent
+ * @brief host simulation of the BLE stack software timer, run by sim_run_us()
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_BLT_SOFT_TIMER_H__
+#define __SIM_BLT_SOFT_TIMER_H__
+
+/* returns < 0 - remove the timer, 0 - keep the interval, > 0 - new interval (us) */
+typedef int (*blt_timer_callback_t)(void);
+
+void blt_soft_timer_init(void);
+int blt_soft_timer_add(blt_timer_callback_t func, unsigned int interval_us);
+int blt_soft_timer_delete(blt_timer_callback_t func);
+
+#endif /* __SIM_BLT_SOFT_TIMER_H__ */
@@ -0,0 +1,65 @@
+/**
+ * @file gpio_8258.h
+ * @author agent
+ * @brief host simulation of the TLSR825x gpio driver, the registers are kept in sim.c
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_GPIO_8258_H__
+#define __SIM_GPIO_8258_H__
+
+#include "sim_reg.h"
+
+/* pin define: group << 8 | bit mask */
+typedef enum {
+    GPIO_GROUPA = 0x000,
+    GPIO_GROUPB = 0x100,
+    GPIO_GROUPC = 0x200,
+    GPIO_GROUPD = 0x300,
+
+    GPIO_PA0 = GPIO_GROUPA | 0x01, GPIO_PA1 = GPIO_GROUPA | 0x02, GPIO_PA2 = GPIO_GROUPA | 0x04, GPIO_PA3 = GPIO_GROUPA | 0x08,
+    GPIO_PA4 = GPIO_GROUPA | 0x10, GPIO_PA5 = GPIO_GROUPA | 0x20, GPIO_PA6 = GPIO_GROUPA | 0x40, GPIO_PA7 = GPIO_GROUPA | 0x80,
+    GPIO_PB0 = GPIO_GROUPB | 0x01, GPIO_PB1 = GPIO_GROUPB | 0x02, GPIO_PB2 = GPIO_GROUPB | 0x04, GPIO_PB3 = GPIO_GROUPB | 0x08,
+    GPIO_PB4 = GPIO_GROUPB | 0x10, GPIO_PB5 = GPIO_GROUPB | 0x20, GPIO_PB6 = GPIO_GROUPB | 0x40, GPIO_PB7 = GPIO_GROUPB | 0x80,
+    GPIO_PC0 = GPIO_GROUPC | 0x01, GPIO_PC1 = GPIO_GROUPC | 0x02, GPIO_PC2 = GPIO_GROUPC | 0x04, GPIO_PC3 = GPIO_GROUPC | 0x08,
+    GPIO_PC4 = GPIO_GROUPC | 0x10, GPIO_PC5 = GPIO_GROUPC | 0x20, GPIO_PC6 = GPIO_GROUPC | 0x40, GPIO_PC7 = GPIO_GROUPC | 0x80,
+    GPIO_PD0 = GPIO_GROUPD | 0x01, GPIO_PD1 = GPIO_GROUPD | 0x02, GPIO_PD2 = GPIO_GROUPD | 0x04, GPIO_PD3 = GPIO_GROUPD | 0x08,
+    GPIO_PD4 = GPIO_GROUPD | 0x10, GPIO_PD5 = GPIO_GROUPD | 0x20, GPIO_PD6 = GPIO_GROUPD | 0x40, GPIO_PD7 = GPIO_GROUPD | 0x80,
+} GPIO_PinTypeDef;
+
+typedef enum {
+    AS_GPIO = 0,
+} GPIO_FuncTypeDef;
+
+typedef enum {
+    pol_rising = 0,
+    pol_falling = 1,
+} GPIO_PolTypeDef;
+
+typedef enum {
+    PM_PIN_UP_DOWN_FLOAT = 0,
+    PM_PIN_PULLUP_1M,
+    PM_PIN_PULLDOWN_100K,
+    PM_PIN_PULLUP_10K,
+} GPIO_PullTypeDef;
+
+/* the input register is read through the board model, e.g. a key matrix wired to the outputs */
+#define reg_gpio_in(i)              (*sim_gpio_in_reg((i) >> 8))
+#define reg_gpio_out(i)             (sim_gpio_out[(i) >> 8])
+
+void gpio_set_func(GPIO_PinTypeDef pin, GPIO_FuncTypeDef func);
+void gpio_set_input_en(GPIO_PinTypeDef pin, unsigned int value);
+void gpio_set_output_en(GPIO_PinTypeDef pin, unsigned int value);
+void gpio_setup_up_down_resistor(GPIO_PinTypeDef gpio, GPIO_PullTypeDef up_down);
+void gpio_write(GPIO_PinTypeDef pin, unsigned int value);
+unsigned int gpio_read(GPIO_PinTypeDef pin);
+void gpio_set_interrupt_pol(GPIO_PinTypeDef pin, GPIO_PolTypeDef falling);
+void gpio_en_interrupt(GPIO_PinTypeDef pin, int en);
+void gpio_en_interrupt_risc0(GPIO_PinTypeDef pin, int en);
+void gpio_en_interrupt_risc1(GPIO_PinTypeDef pin, int en);
+
+#endif /* __SIM_GPIO_8258_H__ */
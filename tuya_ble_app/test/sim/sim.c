@@ -0,0 +1,528 @@
+/**
+ * @file sim.c
+ * @author agent
+ * @brief host simulation of the TLSR825x board for the driver tests
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "sim.h"
+#include "tuya_timer.h"
+#include "gpio_8258.h"
+#include "timer.h"
+#include "adc.h"
+#include "blt_soft_timer.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define SIM_BANK_NUM            4
+#define SIM_IRQ_CH_NUM          3       /* plain gpio, risc0, risc1 */
+#define SIM_IRQ_SRC_MARK        0x80000000  /* set in the value handed out, a driver write clears it */
+#define SIM_SOFT_TIMER_MAX      8
+#define SIM_HW_TIMER_NUM        3
+#define SIM_IRQ_LOOP_MAX        64      /* interrupt storm guard */
+
+#define SIM_PIN_BANK(pin)       (((UINT_T)(pin)) >> 8)
+#define SIM_PIN_MASK(pin)       ((UCHAR_T)((pin) & 0xFF))
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {
+    blt_timer_callback_t cb;
+    UINT_T intv_us;
+    UINT_T due_us;
+} SIM_SOFT_TIMER_T;
+
+typedef struct {
+    UINT_T tick;
+    BOOL_T running;
+    UINT_T due_clock;
+} SIM_HW_TIMER_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+/* registers */
+volatile unsigned int sim_irq_mask = 0;
+volatile unsigned int sim_tmr_sta = 0;
+volatile unsigned char sim_gpio_wakeup_irq = 0;
+volatile unsigned char sim_gpio_out[SIM_BANK_NUM] = {0};
+STATIC volatile unsigned char sg_sim_gpio_in[SIM_BANK_NUM] = {0};
+STATIC UCHAR_T sg_sim_gpio_pol[SIM_BANK_NUM] = {0};
+STATIC UCHAR_T sg_sim_gpio_en[SIM_IRQ_CH_NUM][SIM_BANK_NUM] = {{0}};
+STATIC CONST UINT_T sg_sim_irq_ch_src[SIM_IRQ_CH_NUM] = {
+    FLD_IRQ_GPIO_EN, FLD_IRQ_GPIO_RISC0_EN, FLD_IRQ_GPIO_RISC1_EN
+};
+STATIC BOOL_T sg_sim_irq_line[SIM_IRQ_CH_NUM] = {FALSE};
+STATIC UINT_T sg_sim_irq_pending = 0;
+STATIC volatile unsigned int sg_sim_irq_src_view = 0;
+STATIC UINT_T sg_sim_irq_src_given = 0;
+STATIC BOOL_T sg_sim_in_irq = FALSE;
+STATIC UINT_T sg_sim_gpio_irq_cnt = 0;
+STATIC UINT_T sg_sim_gpio_in_read_cnt = 0;
+
+/* board */
+STATIC UCHAR_T sg_sim_pull[SIM_BANK_NUM] = {0};
+STATIC SIM_BOARD_CB sg_sim_board_cb = NULL;
+STATIC BOOL_T sg_sim_in_board = FALSE;
+STATIC SIM_LOOP_CB sg_sim_loop_cb = NULL;
+STATIC UINT_T sg_sim_adc_mv = 0;
+
+/* time */
+STATIC UINT_T sg_sim_clock = 0;
+STATIC UINT_T sg_sim_time_us = 0;
+STATIC SIM_SOFT_TIMER_T sg_sim_soft_timer[SIM_SOFT_TIMER_MAX] = {{0}};
+STATIC SIM_HW_TIMER_T sg_sim_hw_timer[SIM_HW_TIMER_NUM] = {{0}};
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief apply a driver write to reg_irq_src: the bits written are cleared
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __sim_irq_src_sync(VOID_T)
+{
+    if (sg_sim_irq_src_view != sg_sim_irq_src_given) {
+        sg_sim_irq_pending &= ~sg_sim_irq_src_view;
+    }
+    sg_sim_irq_src_given = sg_sim_irq_pending | SIM_IRQ_SRC_MARK;
+    sg_sim_irq_src_view = sg_sim_irq_src_given;
+}
+
+/**
+ * @brief reg_irq_src access
+ * @param[in] none
+ * @return register
+ */
+volatile unsigned int *sim_irq_src_reg(void)
+{
+    __sim_irq_src_sync();
+    return &sg_sim_irq_src_view;
+}
+
+/**
+ * @brief latch the edges of the interrupt channels: the channel line is the OR of its enabled pins
+ *        at their active level, a rising line sets the interrupt source
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __sim_irq_latch(VOID_T)
+{
+    UCHAR_T ch, bank;
+    BOOL_T line;
+
+    __sim_irq_src_sync();
+    for (ch = 0; ch < SIM_IRQ_CH_NUM; ch++) {
+        line = FALSE;
+        for (bank = 0; bank < SIM_BANK_NUM; bank++) {
+            if ((sg_sim_gpio_in[bank] ^ sg_sim_gpio_pol[bank]) & sg_sim_gpio_en[ch][bank]) {
+                line = TRUE;
+            }
+        }
+        /* the plain gpio channel needs its core enable */
+        if ((0 == ch) && !(sim_gpio_wakeup_irq & FLD_GPIO_CORE_INTERRUPT_EN)) {
+            line = FALSE;
+        }
+        if (line && !sg_sim_irq_line[ch]) {
+            sg_sim_irq_pending |= sg_sim_irq_ch_src[ch];
+        }
+        sg_sim_irq_line[ch] = line;
+    }
+    __sim_irq_src_sync();
+}
+
+/**
+ * @brief enter the gpio interrupt while an enabled source is pending, never nested
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __sim_irq_run(VOID_T)
+{
+    UCHAR_T loop = 0;
+
+    if (sg_sim_in_irq) {
+        return;
+    }
+    __sim_irq_src_sync();
+    while ((sg_sim_irq_pending & sim_irq_mask) && (loop++ < SIM_IRQ_LOOP_MAX)) {
+        sg_sim_in_irq = TRUE;
+        sg_sim_gpio_irq_cnt++;
+        tuya_gpio_irq_handler();
+        sg_sim_in_irq = FALSE;
+        __sim_irq_src_sync();
+    }
+}
+
+/**
+ * @brief update the inputs from the board model, then latch and run the interrupts
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __sim_update(VOID_T)
+{
+    if ((sg_sim_board_cb != NULL) && !sg_sim_in_board) {
+        sg_sim_in_board = TRUE;
+        sg_sim_board_cb();
+        sg_sim_in_board = FALSE;
+    }
+    __sim_irq_latch();
+    __sim_irq_run();
+}
+
+/**
+ * @brief reg_gpio_in access, the board model is applied first
+ * @param[in] bank: gpio bank
+ * @return register
+ */
+volatile unsigned char *sim_gpio_in_reg(unsigned int bank)
+{
+    sg_sim_gpio_in_read_cnt++;
+    __sim_update();
+    return &sg_sim_gpio_in[bank];
+}
+
+VOID_T sim_pin_set(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T level)
+{
+    sim_bank_drive(TY_GPIO_PORT_TO_BANK(port), TY_GPIO_PORT_TO_MASK(port), level ? 0xFF : 0x00);
+}
+
+BOOL_T sim_pin_get_out(IN CONST TY_GPIO_PORT_E port)
+{
+    return (sim_gpio_out[TY_GPIO_PORT_TO_BANK(port)] & TY_GPIO_PORT_TO_MASK(port)) ? TRUE : FALSE;
+}
+
+VOID_T sim_bank_drive(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask, IN CONST UCHAR_T level)
+{
+    sg_sim_gpio_in[bank] = (sg_sim_gpio_in[bank] & ~mask) | (level & mask);
+    if (!sg_sim_in_board) {
+        __sim_update();
+    }
+}
+
+VOID_T sim_set_board(IN SIM_BOARD_CB board_cb)
+{
+    sg_sim_board_cb = board_cb;
+}
+
+VOID_T sim_set_loop(IN SIM_LOOP_CB loop_cb)
+{
+    sg_sim_loop_cb = loop_cb;
+}
+
+VOID_T sim_adc_set_mv(IN CONST UINT_T mv)
+{
+    sg_sim_adc_mv = mv;
+}
+
+UINT_T sim_time_us(VOID_T)
+{
+    return sg_sim_time_us;
+}
+
+UINT_T sim_gpio_irq_cnt(VOID_T)
+{
+    return sg_sim_gpio_irq_cnt;
+}
+
+UINT_T sim_gpio_in_read_cnt(VOID_T)
+{
+    return sg_sim_gpio_in_read_cnt;
+}
+
+UCHAR_T sim_soft_timer_num(VOID_T)
+{
+    UCHAR_T i, num = 0;
+
+    for (i = 0; i < SIM_SOFT_TIMER_MAX; i++) {
+        if (sg_sim_soft_timer[i].cb != NULL) {
+            num++;
+        }
+    }
+    return num;
+}
+
+/**
+ * @brief run the hardware timers that are due, in interrupt context
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __sim_hw_timer_run(VOID_T)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < SIM_HW_TIMER_NUM; i++) {
+        if (!sg_sim_hw_timer[i].running || ((INT_T)(sg_sim_clock - sg_sim_hw_timer[i].due_clock) < 0)) {
+            continue;
+        }
+        sg_sim_hw_timer[i].due_clock += sg_sim_hw_timer[i].tick;
+        sim_tmr_sta = (1u << i);
+        sg_sim_in_irq = TRUE;
+        tuya_timer_irq_handler();
+        sg_sim_in_irq = FALSE;
+    }
+    /* gpio interrupts pending from the timer interrupt */
+    __sim_irq_run();
+}
+
+/**
+ * @brief run the software timers that are due, in main loop context
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __sim_soft_timer_run(VOID_T)
+{
+    UCHAR_T i;
+    INT_T ret;
+    blt_timer_callback_t cb;
+
+    for (i = 0; i < SIM_SOFT_TIMER_MAX; i++) {
+        cb = sg_sim_soft_timer[i].cb;
+        if ((NULL == cb) || ((INT_T)(sg_sim_time_us - sg_sim_soft_timer[i].due_us) < 0)) {
+            continue;
+        }
+        ret = cb();
+        if (sg_sim_soft_timer[i].cb != cb) {
+            continue;
+        }
+        if (ret < 0) {
+            sg_sim_soft_timer[i].cb = NULL;
+            continue;
+        }
+        if (ret > 0) {
+            sg_sim_soft_timer[i].intv_us = ret;
+        }
+        /* rearmed from now as the stack does, a late timer does not catch up */
+        sg_sim_soft_timer[i].due_us = sg_sim_time_us + sg_sim_soft_timer[i].intv_us;
+    }
+}
+
+VOID_T sim_run_us(IN CONST UINT_T us)
+{
+    UINT_T end = sg_sim_time_us + us;
+
+    while ((INT_T)(end - sg_sim_time_us) > 0) {
+        sg_sim_time_us += SIM_STEP_US;
+        sg_sim_clock += SIM_STEP_US * CLOCK_SYS_CLOCK_1US;
+        __sim_update();
+        __sim_hw_timer_run();
+        __sim_soft_timer_run();
+        if (sg_sim_loop_cb != NULL) {
+            sg_sim_loop_cb();
+        }
+    }
+}
+
+VOID_T sim_run_ms(IN CONST UINT_T ms)
+{
+    sim_run_us(ms * 1000);
+}
+
+VOID_T sim_stall_ms(IN CONST UINT_T ms)
+{
+    UINT_T end = sg_sim_time_us + ms * 1000;
+
+    while ((INT_T)(end - sg_sim_time_us) > 0) {
+        sg_sim_time_us += SIM_STEP_US;
+        sg_sim_clock += SIM_STEP_US * CLOCK_SYS_CLOCK_1US;
+        __sim_update();
+        __sim_hw_timer_run();
+    }
+}
+
+/* TLSR825x gpio driver */
+void gpio_set_func(GPIO_PinTypeDef pin, GPIO_FuncTypeDef func)
+{
+}
+
+void gpio_set_input_en(GPIO_PinTypeDef pin, unsigned int value)
+{
+}
+
+void gpio_set_output_en(GPIO_PinTypeDef pin, unsigned int value)
+{
+}
+
+void gpio_setup_up_down_resistor(GPIO_PinTypeDef gpio, GPIO_PullTypeDef up_down)
+{
+    UINT_T bank = SIM_PIN_BANK(gpio);
+    UCHAR_T mask = SIM_PIN_MASK(gpio);
+
+    /* an open input follows its pull resistor until the test drives it */
+    if ((PM_PIN_PULLUP_10K == up_down) || (PM_PIN_PULLUP_1M == up_down)) {
+        if (!(sg_sim_pull[bank] & mask)) {
+            sg_sim_gpio_in[bank] |= mask;
+        }
+    }
+    sg_sim_pull[bank] |= mask;
+    __sim_update();
+}
+
+void gpio_write(GPIO_PinTypeDef pin, unsigned int value)
+{
+    if (value) {
+        sim_gpio_out[SIM_PIN_BANK(pin)] |= SIM_PIN_MASK(pin);
+    } else {
+        sim_gpio_out[SIM_PIN_BANK(pin)] &= ~SIM_PIN_MASK(pin);
+    }
+}
+
+unsigned int gpio_read(GPIO_PinTypeDef pin)
+{
+    return *sim_gpio_in_reg(SIM_PIN_BANK(pin)) & SIM_PIN_MASK(pin);
+}
+
+void gpio_set_interrupt_pol(GPIO_PinTypeDef pin, GPIO_PolTypeDef falling)
+{
+    if (falling) {
+        sg_sim_gpio_pol[SIM_PIN_BANK(pin)] |= SIM_PIN_MASK(pin);
+    } else {
+        sg_sim_gpio_pol[SIM_PIN_BANK(pin)] &= ~SIM_PIN_MASK(pin);
+    }
+    __sim_update();
+}
+
+/**
+ * @brief enable the pin on an interrupt channel
+ * @param[in] ch: channel
+ * @param[in] pin: pin
+ * @param[in] en: enable
+ * @return none
+ */
+STATIC VOID_T __sim_gpio_en(IN CONST UCHAR_T ch, IN CONST GPIO_PinTypeDef pin, IN CONST INT_T en)
+{
+    if (en) {
+        sg_sim_gpio_en[ch][SIM_PIN_BANK(pin)] |= SIM_PIN_MASK(pin);
+    } else {
+        sg_sim_gpio_en[ch][SIM_PIN_BANK(pin)] &= ~SIM_PIN_MASK(pin);
+    }
+    __sim_update();
+}
+
+void gpio_en_interrupt(GPIO_PinTypeDef pin, int en)
+{
+    __sim_gpio_en(0, pin, en);
+}
+
+void gpio_en_interrupt_risc0(GPIO_PinTypeDef pin, int en)
+{
+    __sim_gpio_en(1, pin, en);
+}
+
+void gpio_en_interrupt_risc1(GPIO_PinTypeDef pin, int en)
+{
+    __sim_gpio_en(2, pin, en);
+}
+
+/* TLSR825x timer driver */
+/**
+ * @brief set the period of a hardware timer
+ * @param[in] type: timer
+ * @param[in] cap_tick: period (clock ticks)
+ * @return none
+ */
+STATIC VOID_T __sim_hw_timer_set(IN CONST UCHAR_T type, IN CONST UINT_T cap_tick)
+{
+    sg_sim_hw_timer[type].tick = cap_tick;
+}
+
+void timer0_set_mode(TIMER_ModeTypeDef mode, unsigned int init_tick, unsigned int cap_tick)
+{
+    __sim_hw_timer_set(0, cap_tick);
+}
+
+void timer1_set_mode(TIMER_ModeTypeDef mode, unsigned int init_tick, unsigned int cap_tick)
+{
+    __sim_hw_timer_set(1, cap_tick);
+}
+
+void timer2_set_mode(TIMER_ModeTypeDef mode, unsigned int init_tick, unsigned int cap_tick)
+{
+    __sim_hw_timer_set(2, cap_tick);
+}
+
+void timer_start(int type)
+{
+    sg_sim_hw_timer[type].running = TRUE;
+    sg_sim_hw_timer[type].due_clock = sg_sim_clock + sg_sim_hw_timer[type].tick;
+}
+
+void timer_stop(int type)
+{
+    sg_sim_hw_timer[type].running = FALSE;
+}
+
+unsigned int clock_time(void)
+{
+    /* busy waits on the clock make progress */
+    sg_sim_clock++;
+    __sim_update();
+    return sg_sim_clock;
+}
+
+unsigned int clock_time_exceed(unsigned int ref, unsigned int span_us)
+{
+    return ((unsigned int)(clock_time() - ref) > (span_us * CLOCK_SYS_CLOCK_1US));
+}
+
+/* BLE stack software timer */
+void blt_soft_timer_init(void)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < SIM_SOFT_TIMER_MAX; i++) {
+        sg_sim_soft_timer[i].cb = NULL;
+    }
+}
+
+int blt_soft_timer_add(blt_timer_callback_t func, unsigned int interval_us)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < SIM_SOFT_TIMER_MAX; i++) {
+        if (NULL == sg_sim_soft_timer[i].cb) {
+            sg_sim_soft_timer[i].cb = func;
+            sg_sim_soft_timer[i].intv_us = interval_us;
+            sg_sim_soft_timer[i].due_us = sg_sim_time_us + interval_us;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+int blt_soft_timer_delete(blt_timer_callback_t func)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < SIM_SOFT_TIMER_MAX; i++) {
+        if (sg_sim_soft_timer[i].cb == func) {
+            sg_sim_soft_timer[i].cb = NULL;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* TLSR825x adc driver */
+void adc_init(void)
+{
+}
+
+void adc_base_init(GPIO_PinTypeDef pin)
+{
+}
+
+void adc_power_on_sar_adc(unsigned char on_off)
+{
+}
+
+unsigned int adc_sample_and_get_result(void)
+{
+    return sg_sim_adc_mv;
+}
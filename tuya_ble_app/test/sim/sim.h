@@ -0,0 +1,134 @@
+/**
+ * @file sim.h
+ * @author agent
+ * @brief host simulation of the TLSR825x board for the driver tests
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_H__
+#define __SIM_H__
+
+#include "tuya_common.h"
+#include "tuya_gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define SIM_STEP_US             10      /* time step of sim_run_us() */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef VOID_T (*SIM_LOOP_CB)(VOID_T);     /* main loop function, called every time step */
+typedef VOID_T (*SIM_BOARD_CB)(VOID_T);    /* sets the inputs from the outputs, e.g. a key matrix */
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief set the level of an input pin, edges raise the gpio interrupts at once
+ * @param[in] port: gpio number
+ * @param[in] level: input level
+ * @return none
+ */
+VOID_T sim_pin_set(IN CONST TY_GPIO_PORT_E port, IN CONST BOOL_T level);
+
+/**
+ * @brief get the output level of a pin
+ * @param[in] port: gpio number
+ * @return output level
+ */
+BOOL_T sim_pin_get_out(IN CONST TY_GPIO_PORT_E port);
+
+/**
+ * @brief set the input levels of a bank from the board model
+ * @param[in] bank: gpio bank
+ * @param[in] mask: pins driven by the board
+ * @param[in] level: input levels, bit n - pin n
+ * @return none
+ */
+VOID_T sim_bank_drive(IN CONST TY_GPIO_BANK_E bank, IN CONST UCHAR_T mask, IN CONST UCHAR_T level);
+
+/**
+ * @brief set the board model, called on each input register read and clock read
+ * @param[in] board_cb: board model, NULL - none
+ * @return none
+ */
+VOID_T sim_set_board(IN SIM_BOARD_CB board_cb);
+
+/**
+ * @brief set the main loop function
+ * @param[in] loop_cb: main loop function, NULL - none
+ * @return none
+ */
+VOID_T sim_set_loop(IN SIM_LOOP_CB loop_cb);
+
+/**
+ * @brief set the adc input voltage
+ * @param[in] mv: voltage (mV)
+ * @return none
+ */
+VOID_T sim_adc_set_mv(IN CONST UINT_T mv);
+
+/**
+ * @brief run the main loop, the software timers and the hardware timers
+ * @param[in] us: time to run (us)
+ * @return none
+ */
+VOID_T sim_run_us(IN CONST UINT_T us);
+
+/**
+ * @brief run the main loop, the software timers and the hardware timers
+ * @param[in] ms: time to run (ms)
+ * @return none
+ */
+VOID_T sim_run_ms(IN CONST UINT_T ms);
+
+/**
+ * @brief block the main loop, only the hardware timers and the interrupts run, e.g. a long radio event
+ * @param[in] ms: time blocked (ms)
+ * @return none
+ */
+VOID_T sim_stall_ms(IN CONST UINT_T ms);
+
+/**
+ * @brief get the simulated time
+ * @param[in] none
+ * @return time since the start (us)
+ */
+UINT_T sim_time_us(VOID_T);
+
+/**
+ * @brief get the number of gpio interrupts entered
+ * @param[in] none
+ * @return gpio interrupts
+ */
+UINT_T sim_gpio_irq_cnt(VOID_T);
+
+/**
+ * @brief get the number of gpio input register reads
+ * @param[in] none
+ * @return register reads
+ */
+UINT_T sim_gpio_in_read_cnt(VOID_T);
+
+/**
+ * @brief get the number of running software timers
+ * @param[in] none
+ * @return software timers
+ */
+UCHAR_T sim_soft_timer_num(VOID_T);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __SIM_H__ */
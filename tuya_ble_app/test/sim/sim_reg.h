@@ -0,0 +1,45 @@
+/**
+ * @file sim_reg.h
+ * @author agent
+ * @brief host simulation of the TLSR825x registers used by the platform drivers
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_REG_H__
+#define __SIM_REG_H__
+
+#define CLOCK_SYS_CLOCK_1US         16
+
+/* interrupt sources */
+#define FLD_IRQ_GPIO_EN             (1 << 18)
+#define FLD_IRQ_GPIO_RISC0_EN       (1 << 21)
+#define FLD_IRQ_GPIO_RISC1_EN       (1 << 22)
+
+/* gpio core interrupt enable of the plain gpio channel */
+#define FLD_GPIO_CORE_WAKEUP_EN     (1 << 2)
+#define FLD_GPIO_CORE_INTERRUPT_EN  (1 << 3)
+
+/* timer status */
+#define FLD_TMR_STA_TMR0            (1 << 0)
+#define FLD_TMR_STA_TMR1            (1 << 1)
+#define FLD_TMR_STA_TMR2            (1 << 2)
+
+/* reg_irq_src is write 1 to clear, emulated on the next access */
+#define reg_irq_src                 (*sim_irq_src_reg())
+#define reg_irq_mask                sim_irq_mask
+#define reg_tmr_sta                 sim_tmr_sta
+#define reg_gpio_wakeup_irq         sim_gpio_wakeup_irq
+
+extern volatile unsigned int sim_irq_mask;
+extern volatile unsigned int sim_tmr_sta;
+extern volatile unsigned char sim_gpio_wakeup_irq;
+extern volatile unsigned char sim_gpio_out[4];
+
+volatile unsigned int *sim_irq_src_reg(void);
+volatile unsigned char *sim_gpio_in_reg(unsigned int bank);
+
+#endif /* __SIM_REG_H__ */
@@ -0,0 +1,29 @@
+/**
+ * @file timer.h
+ * @author agent
+ * @brief host simulation of the TLSR825x timer driver
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_TIMER_H__
+#define __SIM_TIMER_H__
+
+#include "sim_reg.h"
+
+typedef enum {
+    TIMER_MODE_SYSCLK = 0,
+} TIMER_ModeTypeDef;
+
+void timer0_set_mode(TIMER_ModeTypeDef mode, unsigned int init_tick, unsigned int cap_tick);
+void timer1_set_mode(TIMER_ModeTypeDef mode, unsigned int init_tick, unsigned int cap_tick);
+void timer2_set_mode(TIMER_ModeTypeDef mode, unsigned int init_tick, unsigned int cap_tick);
+void timer_start(int type);
+void timer_stop(int type);
+unsigned int clock_time(void);
+unsigned int clock_time_exceed(unsigned int ref, unsigned int span_us);
+
+#endif /* __SIM_TIMER_H__ */
@@ -0,0 +1,19 @@
+/**
+ * @file tuya_ble_log.h
+ * @author agent
+ * @brief host simulation of the tuya ble sdk log
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __SIM_TUYA_BLE_LOG_H__
+#define __SIM_TUYA_BLE_LOG_H__
+
+#define TUYA_APP_LOG_INFO(...)
+#define TUYA_APP_LOG_ERROR(...)
+#define TUYA_APP_LOG_DEBUG(...)
+
+#endif /* __SIM_TUYA_BLE_LOG_H__ */
@@ -0,0 +1,66 @@
+/**
+ * @file test.h
+ * @author agent
+ * @brief host test checks
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <stdio.h>
+#include "tuya_common.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+/* check a condition, a failed check is printed and counted */
+#define TEST_CHECK(cond) \
+    do { \
+        test_check_cnt++; \
+        if (!(cond)) { \
+            test_fail_cnt++; \
+            printf("%s:%d: %s: check failed: %s\n", __FILE__, __LINE__, __func__, #cond); \
+        } \
+    } while (0)
+
+/* check two integer values are equal */
+#define TEST_CHECK_EQ(a, b) \
+    do { \
+        long test_a_ = (long)(a), test_b_ = (long)(b); \
+        test_check_cnt++; \
+        if (test_a_ != test_b_) { \
+            test_fail_cnt++; \
+            printf("%s:%d: %s: check failed: %s == %s (%ld != %ld)\n", \
+                   __FILE__, __LINE__, __func__, #a, #b, test_a_, test_b_); \
+        } \
+    } while (0)
+
+/* run a test case */
+#define TEST_RUN(test_fn) \
+    do { \
+        UINT_T test_fail_ = test_fail_cnt; \
+        test_fn(); \
+        printf("%-48s %s\n", #test_fn, (test_fail_ == test_fail_cnt) ? "ok" : "FAILED"); \
+    } while (0)
+
+/* print the result, return value of main() */
+#define TEST_RESULT() \
+    (printf("%s: %u checks, %u failed\n", __FILE__, test_check_cnt, test_fail_cnt), (test_fail_cnt ? 1 : 0))
+
+/* defined once in each test file */
+#define TEST_DEFINE() \
+    UINT_T test_check_cnt = 0; \
+    UINT_T test_fail_cnt = 0
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+extern UINT_T test_check_cnt;
+extern UINT_T test_fail_cnt;
+
+#endif /* __TEST_H__ */
@@ -0,0 +1,142 @@
+/**
+ * @file test_encoder.c
+ * @author agent
+ * @brief rotary encoder driver host test
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "test.h"
+#include "sim.h"
+#include "tuya_encoder.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define ENC_A_PORT          TY_GPIOB_4
+#define ENC_B_PORT          TY_GPIOB_5
+#define ENC_BAD_PORT        TY_GPIOA_2      /* not bonded out */
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC INT_T sg_detent = 0;
+STATIC UINT_T sg_velocity = 0;
+STATIC UINT_T sg_cb_cnt = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __encoder_cb(INT_T detent, UINT_T velocity)
+{
+    sg_detent += detent;
+    sg_velocity = velocity;
+    sg_cb_cnt++;
+}
+
+/**
+ * @brief set the active state of both channels, active low
+ * @param[in] ab: bit 1 - A, bit 0 - B, 1 - active
+ * @return none
+ */
+STATIC VOID_T __ab_set(IN CONST UCHAR_T ab)
+{
+    sim_pin_set(ENC_A_PORT, !(ab & 0x02));
+    sim_pin_set(ENC_B_PORT, !(ab & 0x01));
+}
+
+/**
+ * @brief turn the encoder by one detent of 4 steps
+ * @param[in] cw: TRUE - clockwise, A leads B
+ * @param[in] step_us: time per step
+ * @return none
+ */
+STATIC VOID_T __detent_turn(IN CONST BOOL_T cw, IN CONST UINT_T step_us)
+{
+    STATIC CONST UCHAR_T cw_seq[4] = {0x02, 0x03, 0x01, 0x00};
+    STATIC CONST UCHAR_T ccw_seq[4] = {0x01, 0x03, 0x02, 0x00};
+    UCHAR_T i;
+
+    for (i = 0; i < 4; i++) {
+        __ab_set(cw ? cw_seq[i] : ccw_seq[i]);
+        sim_run_us(step_us);
+    }
+}
+
+/* a failed init leaves the driver free for a good one */
+STATIC VOID_T test_encoder_init(VOID_T)
+{
+    STATIC ENCODER_DEF_T enc = {ENC_BAD_PORT, ENC_B_PORT, TRUE, 4, __encoder_cb};
+
+    __ab_set(0x00);
+    TEST_CHECK_EQ(tuya_encoder_init(&enc), ENCODER_ERR_INVALID_PARM);
+    enc.port_a = ENC_A_PORT;
+    enc.step_per_detent = 3;
+    TEST_CHECK_EQ(tuya_encoder_init(&enc), ENCODER_ERR_INVALID_PARM);
+    enc.step_per_detent = 4;
+    TEST_CHECK_EQ(tuya_encoder_init(&enc), ENCODER_OK);
+    TEST_CHECK_EQ(tuya_encoder_init(&enc), ENCODER_ERR_INVALID_STATE);
+}
+
+/* full quadrature cycles are reported as detents with the direction */
+STATIC VOID_T test_encoder_detent(VOID_T)
+{
+    ENCODER_STAT_T stat;
+
+    sg_detent = 0;
+    sg_cb_cnt = 0;
+    __detent_turn(TRUE, 1000);
+    __detent_turn(TRUE, 1000);
+    tuya_encoder_loop();
+    TEST_CHECK_EQ(sg_detent, 2);
+    TEST_CHECK_EQ(sg_cb_cnt, 1);
+    /* 4 ms per detent */
+    TEST_CHECK_EQ(sg_velocity, 250);
+
+    __detent_turn(FALSE, 1000);
+    tuya_encoder_loop();
+    TEST_CHECK_EQ(sg_detent, 1);
+    TEST_CHECK_EQ(sg_cb_cnt, 2);
+    tuya_encoder_loop();
+    TEST_CHECK_EQ(sg_cb_cnt, 2);
+
+    tuya_encoder_get_stat(&stat);
+    TEST_CHECK_EQ(stat.step_cnt, 12);
+    TEST_CHECK_EQ(stat.error_cnt, 0);
+}
+
+/* both channels changed is an error, not a step */
+STATIC VOID_T test_encoder_missed_step(VOID_T)
+{
+    ENCODER_STAT_T stat;
+
+    sg_detent = 0;
+    /* A and B both active at once, then back to idle */
+    sim_bank_drive(TY_GPIO_BANK_B, 0x30, 0x00);
+    sim_run_us(1000);
+    sim_bank_drive(TY_GPIO_BANK_B, 0x30, 0x30);
+    sim_run_us(1000);
+    tuya_encoder_loop();
+    TEST_CHECK_EQ(sg_detent, 0);
+    tuya_encoder_get_stat(&stat);
+    TEST_CHECK_EQ(stat.step_cnt, 12);
+    TEST_CHECK_EQ(stat.error_cnt, 2);
+}
+
+int main(int argc, char *argv[])
+{
+    TEST_RUN(test_encoder_init);
+    TEST_RUN(test_encoder_detent);
+    TEST_RUN(test_encoder_missed_step);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,352 @@
+/**
+ * @file test_gpio.c
+ * @author agent
+ * @brief gpio driver host test
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "test.h"
+#include "sim.h"
+#include "sim_reg.h"
+#include "tuya_gpio.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define RISE_A_PORT         TY_GPIOB_4
+#define RISE_B_PORT         TY_GPIOB_5
+#define FALL_A_PORT         TY_GPIOC_0
+#define FALL_B_PORT         TY_GPIOC_1
+#define BOTH_PORT           TY_GPIOD_2
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC UINT_T sg_irq_cnt[TY_GPIO_MAX];
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __irq_cb(TY_GPIO_PORT_E port)
+{
+    sg_irq_cnt[port]++;
+}
+
+/**
+ * @brief set all test pins to a level and clear the callback counts
+ * @param[in] level: pin level
+ * @return none
+ */
+STATIC VOID_T __case_start(IN CONST BOOL_T level)
+{
+    UCHAR_T i;
+
+    sim_pin_set(RISE_A_PORT, level);
+    sim_pin_set(RISE_B_PORT, level);
+    sim_pin_set(FALL_A_PORT, level);
+    sim_pin_set(FALL_B_PORT, level);
+    sim_pin_set(BOTH_PORT, level);
+    for (i = 0; i < TY_GPIO_MAX; i++) {
+        sg_irq_cnt[i] = 0;
+    }
+}
+
+/* a rising pin held high is not dispatched again by the edges of other pins */
+STATIC VOID_T test_irq_rise_changed_only(VOID_T)
+{
+    UINT_T irq_cnt;
+
+    __case_start(FALSE);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(RISE_A_PORT, TY_GPIO_IRQ_RISING, __irq_cb), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(RISE_B_PORT, TY_GPIO_IRQ_RISING, __irq_cb), GPIO_OK);
+
+    sim_pin_set(RISE_A_PORT, TRUE);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 1);
+    /* pin a still high: the channel is free for pin b */
+    sim_pin_set(RISE_B_PORT, TRUE);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_B_PORT], 1);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 1);
+    /* falling edges are not dispatched */
+    sim_pin_set(RISE_A_PORT, FALSE);
+    sim_pin_set(RISE_B_PORT, FALSE);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 1);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_B_PORT], 1);
+    sim_pin_set(RISE_A_PORT, TRUE);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 2);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_B_PORT], 1);
+    /* the falling edge takes an interrupt too, two per pulse */
+    irq_cnt = sim_gpio_irq_cnt();
+    sim_pin_set(RISE_B_PORT, TRUE);
+    sim_pin_set(RISE_B_PORT, FALSE);
+    TEST_CHECK_EQ(sim_gpio_irq_cnt() - irq_cnt, 2);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_B_PORT], 2);
+
+    tuya_gpio_irq_deinit(RISE_A_PORT);
+    tuya_gpio_irq_deinit(RISE_B_PORT);
+}
+
+STATIC VOID_T test_irq_fall_changed_only(VOID_T)
+{
+    __case_start(TRUE);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(FALL_A_PORT, TY_GPIO_IRQ_FALLING, __irq_cb), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(FALL_B_PORT, TY_GPIO_IRQ_FALLING, __irq_cb), GPIO_OK);
+
+    sim_pin_set(FALL_A_PORT, FALSE);
+    sim_pin_set(FALL_B_PORT, FALSE);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_A_PORT], 1);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_B_PORT], 1);
+    sim_pin_set(FALL_B_PORT, TRUE);
+    sim_pin_set(FALL_B_PORT, FALSE);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_A_PORT], 1);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_B_PORT], 2);
+
+    tuya_gpio_irq_deinit(FALL_A_PORT);
+    tuya_gpio_irq_deinit(FALL_B_PORT);
+}
+
+STATIC VOID_T test_irq_init_at_active_level(VOID_T)
+{
+    /* a pin already at its active level fires on the next edge only */
+    __case_start(TRUE);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(RISE_A_PORT, TY_GPIO_IRQ_RISING, __irq_cb), GPIO_OK);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 0);
+    sim_pin_set(RISE_A_PORT, FALSE);
+    sim_pin_set(RISE_A_PORT, TRUE);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 1);
+    tuya_gpio_irq_deinit(RISE_A_PORT);
+
+    /* deinit: no more callbacks */
+    sim_pin_set(RISE_A_PORT, FALSE);
+    sim_pin_set(RISE_A_PORT, TRUE);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 1);
+}
+
+STATIC VOID_T test_irq_both_edges(VOID_T)
+{
+    TY_GPIO_EDGE_T edge;
+
+    __case_start(FALSE);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(BOTH_PORT, TY_GPIO_IRQ_BOTH, __irq_cb), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(RISE_A_PORT, TY_GPIO_IRQ_RISING, __irq_cb), GPIO_OK);
+    sim_pin_set(BOTH_PORT, TRUE);
+    sim_pin_set(RISE_A_PORT, TRUE);
+    sim_pin_set(BOTH_PORT, FALSE);
+    TEST_CHECK_EQ(sg_irq_cnt[BOTH_PORT], 2);
+    TEST_CHECK_EQ(sg_irq_cnt[RISE_A_PORT], 1);
+    tuya_gpio_irq_deinit(BOTH_PORT);
+    tuya_gpio_irq_deinit(RISE_A_PORT);
+
+    /* edge fifo: level and order of the edges */
+    TEST_CHECK_EQ(tuya_gpio_edge_init(BOTH_PORT), GPIO_OK);
+    sim_pin_set(BOTH_PORT, TRUE);
+    sim_run_us(100);
+    sim_pin_set(BOTH_PORT, FALSE);
+    TEST_CHECK(tuya_gpio_edge_get(&edge));
+    TEST_CHECK_EQ(edge.port, BOTH_PORT);
+    TEST_CHECK_EQ(edge.level, TRUE);
+    TEST_CHECK(tuya_gpio_edge_get(&edge));
+    TEST_CHECK_EQ(edge.level, FALSE);
+    TEST_CHECK(!tuya_gpio_edge_get(&edge));
+    tuya_gpio_irq_deinit(BOTH_PORT);
+}
+
+/* a disabled pin keeps its setting, its edges are not reported */
+STATIC VOID_T test_irq_set_enable(VOID_T)
+{
+    __case_start(TRUE);
+    TEST_CHECK_EQ(tuya_gpio_irq_set_enable(FALL_A_PORT, FALSE), GPIO_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(FALL_A_PORT, TY_GPIO_IRQ_FALLING, __irq_cb), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(FALL_B_PORT, TY_GPIO_IRQ_FALLING, __irq_cb), GPIO_OK);
+
+    TEST_CHECK_EQ(tuya_gpio_irq_set_enable(FALL_A_PORT, FALSE), GPIO_OK);
+    sim_pin_set(FALL_A_PORT, FALSE);
+    sim_pin_set(FALL_B_PORT, FALSE);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_A_PORT], 0);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_B_PORT], 1);
+    /* enabled at the active level: the next fall fires */
+    TEST_CHECK_EQ(tuya_gpio_irq_set_enable(FALL_A_PORT, TRUE), GPIO_OK);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_A_PORT], 0);
+    sim_pin_set(FALL_A_PORT, TRUE);
+    sim_pin_set(FALL_A_PORT, FALSE);
+    TEST_CHECK_EQ(sg_irq_cnt[FALL_A_PORT], 1);
+
+    tuya_gpio_irq_deinit(FALL_A_PORT);
+    tuya_gpio_irq_deinit(FALL_B_PORT);
+}
+
+/* a hold-off counts the edges it hid, a burst back to the masked level included */
+STATIC VOID_T test_holdoff_suppress(VOID_T)
+{
+    TY_GPIO_HOLDOFF_STAT_T stat;
+
+    __case_start(TRUE);
+    TEST_CHECK_EQ(tuya_gpio_irq_set_holdoff(BOTH_PORT, TRUE), GPIO_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_gpio_irq_holdoff_init(TY_TIMER_0, 2000), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_irq_init(BOTH_PORT, TY_GPIO_IRQ_BOTH, __irq_cb), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_irq_set_holdoff(BOTH_PORT, TRUE), GPIO_OK);
+    tuya_gpio_clr_holdoff_stat();
+
+    /* a bounce back to the masked level */
+    sim_pin_set(BOTH_PORT, FALSE);
+    sim_run_us(100);
+    sim_pin_set(BOTH_PORT, TRUE);
+    sim_run_us(100);
+    sim_pin_set(BOTH_PORT, FALSE);
+    sim_run_ms(5);
+    TEST_CHECK_EQ(sg_irq_cnt[BOTH_PORT], 1);
+    tuya_gpio_get_holdoff_stat(&stat);
+    TEST_CHECK_EQ(stat.holdoff_cnt, 1);
+    TEST_CHECK_EQ(stat.suppress_cnt, 1);
+
+    /* a clean edge hides nothing */
+    sim_pin_set(BOTH_PORT, TRUE);
+    sim_run_ms(5);
+    TEST_CHECK_EQ(sg_irq_cnt[BOTH_PORT], 2);
+    tuya_gpio_get_holdoff_stat(&stat);
+    TEST_CHECK_EQ(stat.holdoff_cnt, 2);
+    TEST_CHECK_EQ(stat.suppress_cnt, 1);
+
+    /* a burst to the other level: one edge to the final level when the hold-off ends */
+    sim_pin_set(BOTH_PORT, FALSE);
+    sim_run_us(100);
+    sim_pin_set(BOTH_PORT, TRUE);
+    sim_run_us(100);
+    sim_pin_set(BOTH_PORT, FALSE);
+    sim_run_us(100);
+    sim_pin_set(BOTH_PORT, TRUE);
+    sim_run_ms(10);
+    TEST_CHECK_EQ(sg_irq_cnt[BOTH_PORT], 4);
+    tuya_gpio_get_holdoff_stat(&stat);
+    TEST_CHECK_EQ(stat.holdoff_cnt, 4);
+    TEST_CHECK_EQ(stat.suppress_cnt, 2);
+
+    /* the latch never interrupts */
+    TEST_CHECK_EQ(sim_irq_mask & FLD_IRQ_GPIO_EN, 0);
+    tuya_gpio_irq_deinit(BOTH_PORT);
+}
+
+/* the bank writes touch only the bonded pins in the mask */
+/* the edges of all edge pins in one fifo in the order they happened, a full fifo keeps the oldest */
+STATIC VOID_T test_edge_fifo(VOID_T)
+{
+    STATIC CONST TY_GPIO_PORT_E port[4] = {RISE_A_PORT, FALL_A_PORT, RISE_A_PORT, FALL_A_PORT};
+    STATIC CONST BOOL_T level[4] = {TRUE, TRUE, FALSE, FALSE};
+    TY_GPIO_EDGE_T edge;
+    UINT_T lost, time = 0;
+    UCHAR_T i;
+
+    __case_start(FALSE);
+    TEST_CHECK_EQ(tuya_gpio_edge_init(RISE_A_PORT), GPIO_OK);
+    TEST_CHECK_EQ(tuya_gpio_edge_init(FALL_A_PORT), GPIO_OK);
+    lost = tuya_gpio_edge_get_lost_cnt();
+    TEST_CHECK(!tuya_gpio_edge_get(&edge));
+
+    /* edges of two banks, interleaved */
+    for (i = 0; i < 4; i++) {
+        sim_pin_set(port[i], level[i]);
+        sim_run_us(20);
+    }
+    for (i = 0; i < 4; i++) {
+        TEST_CHECK(tuya_gpio_edge_get(&edge));
+        TEST_CHECK_EQ(edge.port, port[i]);
+        TEST_CHECK_EQ(edge.level, level[i]);
+        TEST_CHECK((0 == i) || ((INT_T)(edge.time - time) > 0));
+        time = edge.time;
+    }
+    TEST_CHECK(!tuya_gpio_edge_get(&edge));
+
+    /* 20 edges, the last 4 are lost */
+    for (i = 0; i < TY_GPIO_EDGE_FIFO_SIZE + 4; i++) {
+        sim_pin_set(RISE_A_PORT, (i & 1) ? FALSE : TRUE);
+        sim_run_us(20);
+    }
+    TEST_CHECK_EQ(tuya_gpio_edge_get_lost_cnt() - lost, 4);
+    for (i = 0; i < TY_GPIO_EDGE_FIFO_SIZE; i++) {
+        TEST_CHECK(tuya_gpio_edge_get(&edge));
+        TEST_CHECK_EQ(edge.level, (i & 1) ? FALSE : TRUE);
+    }
+    TEST_CHECK(!tuya_gpio_edge_get(&edge));
+
+    /* room again */
+    sim_pin_set(RISE_A_PORT, TRUE);
+    TEST_CHECK(tuya_gpio_edge_get(&edge));
+    TEST_CHECK_EQ(edge.level, TRUE);
+    TEST_CHECK_EQ(tuya_gpio_edge_get_lost_cnt() - lost, 4);
+
+    tuya_gpio_irq_deinit(RISE_A_PORT);
+    tuya_gpio_irq_deinit(FALL_A_PORT);
+}
+
+/* a resolved pin reads and writes its own bit only, pins missing on the chip are refused */
+STATIC VOID_T test_pin_handle(VOID_T)
+{
+    TY_GPIO_PIN_T pin;
+
+    TEST_CHECK_EQ(tuya_gpio_pin_get(TY_GPIOA_2, &pin), GPIO_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_gpio_pin_get(TY_GPIO_MAX, &pin), GPIO_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_gpio_pin_get(RISE_A_PORT, &pin), GPIO_OK);
+
+    sim_pin_set(RISE_A_PORT, TRUE);
+    sim_pin_set(RISE_B_PORT, FALSE);
+    TEST_CHECK(tuya_gpio_pin_read(&pin));
+    TEST_CHECK(tuya_gpio_read(RISE_A_PORT));
+    sim_pin_set(RISE_A_PORT, FALSE);
+    sim_pin_set(RISE_B_PORT, TRUE);
+    TEST_CHECK(!tuya_gpio_pin_read(&pin));
+
+    sim_gpio_out[TY_GPIO_BANK_B] = 0x20;
+    tuya_gpio_pin_write(&pin, TRUE);
+    TEST_CHECK_EQ(sim_gpio_out[TY_GPIO_BANK_B], 0x30);
+    TEST_CHECK(sim_pin_get_out(RISE_A_PORT));
+    tuya_gpio_pin_write(&pin, FALSE);
+    TEST_CHECK_EQ(sim_gpio_out[TY_GPIO_BANK_B], 0x20);
+    sim_gpio_out[TY_GPIO_BANK_B] = 0x00;
+}
+
+STATIC VOID_T test_bank_write(VOID_T)
+{
+    /* PB0 PB2 PB3 are not bonded out, their output bits must keep their values */
+    sim_gpio_out[TY_GPIO_BANK_B] = 0x0C;
+
+    TEST_CHECK_EQ(tuya_gpio_set_bank(TY_GPIO_BANK_B, 0xFF), GPIO_OK);
+    TEST_CHECK_EQ(sim_gpio_out[TY_GPIO_BANK_B], 0xFE);
+    TEST_CHECK_EQ(tuya_gpio_clr_bank(TY_GPIO_BANK_B, 0xFF), GPIO_OK);
+    TEST_CHECK_EQ(sim_gpio_out[TY_GPIO_BANK_B], 0x0C);
+    TEST_CHECK_EQ(tuya_gpio_toggle_bank(TY_GPIO_BANK_B, 0x33), GPIO_OK);
+    TEST_CHECK_EQ(sim_gpio_out[TY_GPIO_BANK_B], 0x3E);
+    TEST_CHECK_EQ(tuya_gpio_write_bank(TY_GPIO_BANK_B, 0xFF, 0xA5), GPIO_OK);
+    TEST_CHECK_EQ(sim_gpio_out[TY_GPIO_BANK_B], 0xAC);
+    TEST_CHECK(sim_pin_get_out(TY_GPIOB_7));
+    TEST_CHECK(!sim_pin_get_out(TY_GPIOB_4));
+
+    TEST_CHECK_EQ(tuya_gpio_set_bank(TY_GPIO_BANK_MAX, 0xFF), GPIO_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_gpio_write_bank(TY_GPIO_BANK_MAX, 0xFF, 0x00), GPIO_ERR_INVALID_PARM);
+    sim_gpio_out[TY_GPIO_BANK_B] = 0x00;
+}
+
+int main(int argc, char *argv[])
+{
+    tuya_software_timer_init();
+
+    TEST_RUN(test_irq_rise_changed_only);
+    TEST_RUN(test_irq_fall_changed_only);
+    TEST_RUN(test_irq_init_at_active_level);
+    TEST_RUN(test_irq_both_edges);
+    TEST_RUN(test_irq_set_enable);
+    TEST_RUN(test_holdoff_suppress);
+    TEST_RUN(test_edge_fifo);
+    TEST_RUN(test_pin_handle);
+    TEST_RUN(test_bank_write);
+
+    return TEST_RESULT();
+}
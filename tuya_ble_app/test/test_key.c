@@ -0,0 +1,977 @@
+/**
+ * @file test_key.c
+ * @author agent
+ * @brief key driver host test
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "test.h"
+#include "sim.h"
+#include "tuya_key.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_A_PORT          TY_GPIOB_4
+#define KEY_B_PORT          TY_GPIOB_5
+#define KEY_C_PORT          TY_GPIOC_0      /* chord keys, stay registered */
+#define KEY_D_PORT          TY_GPIOC_1
+#define EVT_REC_MAX         64
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+typedef struct {
+    KEY_EVENT_T evt;
+    CONST KEY_DEF_T *key;   /* key of the event, NULL - chord */
+    UINT_T rx_ms;           /* simulated time when the event was received (ms) */
+} EVT_REC_T;
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC EVT_REC_T sg_evt_rec[EVT_REC_MAX];
+STATIC UCHAR_T sg_evt_num = 0;
+
+STATIC KEY_DEF_T sg_key_a;
+STATIC KEY_DEF_T sg_key_b;
+STATIC KEY_DEF_T sg_key_c;
+STATIC KEY_DEF_T sg_key_d;
+STATIC UCHAR_T sg_chord_cnt = 0;
+
+STATIC KEY_DEF_T sg_key_upd[3];         /* defines sg_key_a is updated to */
+STATIC KEY_DEF_T sg_key_upd_b;          /* define sg_key_b is updated to */
+STATIC UINT_T sg_src_state[3];          /* raw states of the key sources */
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief record a key event
+ * @param[in] key: key of the event
+ * @param[in] evt: key event
+ * @return none
+ */
+STATIC VOID_T __evt_rec(IN CONST KEY_DEF_T *key, IN CONST KEY_EVENT_T *evt)
+{
+    if (sg_evt_num < EVT_REC_MAX) {
+        sg_evt_rec[sg_evt_num].evt = *evt;
+        sg_evt_rec[sg_evt_num].key = key;
+        sg_evt_rec[sg_evt_num].rx_ms = sim_time_us() / 1000;
+        sg_evt_num++;
+    }
+}
+
+STATIC VOID_T __key_a_evt_cb(IN CONST KEY_EVENT_T *evt)
+{
+    __evt_rec(&sg_key_a, evt);
+}
+
+STATIC VOID_T __key_b_evt_cb(IN CONST KEY_EVENT_T *evt)
+{
+    __evt_rec(&sg_key_b, evt);
+}
+
+STATIC VOID_T __key_c_evt_cb(IN CONST KEY_EVENT_T *evt)
+{
+    __evt_rec(&sg_key_c, evt);
+}
+
+STATIC VOID_T __key_d_evt_cb(IN CONST KEY_EVENT_T *evt)
+{
+    __evt_rec(&sg_key_d, evt);
+}
+
+STATIC VOID_T __key_b_cb(IN KEY_PRESS_TYPE_E type)
+{
+    KEY_EVENT_T evt = {0};
+
+    evt.type = type;
+    __evt_rec(&sg_key_b, &evt);
+}
+
+STATIC VOID_T __chord_cb(IN KEY_PRESS_TYPE_E type)
+{
+    if (CHORD_PRESS == type) {
+        sg_chord_cnt++;
+    }
+}
+
+STATIC UINT_T __src_0_read(VOID_T)
+{
+    return sg_src_state[0];
+}
+
+STATIC UINT_T __src_1_read(VOID_T)
+{
+    return sg_src_state[1];
+}
+
+STATIC UINT_T __src_2_read(VOID_T)
+{
+    return sg_src_state[2];
+}
+
+STATIC CONST KEY_SRC_T sg_key_src[3] = {
+    {__src_0_read, FALSE}, {__src_1_read, FALSE}, {__src_2_read, FALSE}
+};
+
+/**
+ * @brief count recorded events
+ * @param[in] key: key of the events
+ * @param[in] type: event type
+ * @return number of events
+ */
+STATIC UCHAR_T __evt_cnt(IN CONST KEY_DEF_T *key, IN CONST KEY_PRESS_TYPE_E type)
+{
+    UCHAR_T i, cnt = 0;
+
+    for (i = 0; i < sg_evt_num; i++) {
+        if ((sg_evt_rec[i].key == key) && (sg_evt_rec[i].evt.type == type)) {
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+/**
+ * @brief find a recorded event
+ * @param[in] key: key of the event
+ * @param[in] type: event type
+ * @return first event, NULL - none
+ */
+STATIC CONST EVT_REC_T *__evt_find(IN CONST KEY_DEF_T *key, IN CONST KEY_PRESS_TYPE_E type)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < sg_evt_num; i++) {
+        if ((sg_evt_rec[i].key == key) && (sg_evt_rec[i].evt.type == type)) {
+            return &sg_evt_rec[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief set a key define with an event callback
+ * @param[out] key: key define
+ * @param[in] port: key port
+ * @param[in] evt_cb: event callback
+ * @return none
+ */
+STATIC VOID_T __key_def_set(OUT KEY_DEF_T *key, IN CONST TY_GPIO_PORT_E port, IN KEY_EVENT_CALLBACK evt_cb)
+{
+    memset(key, 0, SIZEOF(KEY_DEF_T));
+    key->port = port;
+    key->active_low = TRUE;
+    key->evt_cb = evt_cb;
+}
+
+/**
+ * @brief register a key
+ * @param[in] key: key define
+ * @return none
+ */
+STATIC VOID_T __key_reg(IN KEY_DEF_T *key)
+{
+    sim_pin_set(key->port, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key(key), KEY_OK);
+}
+
+/**
+ * @brief unregister a key, the keys are released first
+ * @param[in] key: key define
+ * @return none
+ */
+STATIC VOID_T __key_unreg(IN CONST KEY_DEF_T *key)
+{
+    KEY_HANDLE handle;
+
+    TEST_CHECK_EQ(tuya_key_get_handle(key, &handle), KEY_OK);
+    TEST_CHECK_EQ(tuya_unreg_key(handle), KEY_OK);
+}
+
+/**
+ * @brief start a test case, all keys released and no events recorded
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __case_start(VOID_T)
+{
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_pin_set(KEY_B_PORT, TRUE);
+    sim_pin_set(KEY_C_PORT, TRUE);
+    sim_pin_set(KEY_D_PORT, TRUE);
+    sim_run_ms(500);
+    sg_evt_num = 0;
+    sg_chord_cnt = 0;
+}
+
+/**
+ * @brief toggle a key every period, ends released
+ * @param[in] port: key port
+ * @param[in] num: number of toggles
+ * @param[in] period_us: toggle period (us)
+ * @return none
+ */
+STATIC VOID_T __key_bounce(IN CONST TY_GPIO_PORT_E port, IN CONST UCHAR_T num, IN CONST UINT_T period_us)
+{
+    UCHAR_T i;
+
+    for (i = 0; i < num; i++) {
+        sim_pin_set(port, (i & 1) ? TRUE : FALSE);
+        sim_run_us(period_us);
+    }
+    sim_pin_set(port, TRUE);
+}
+
+/* default keys of a bank share a 2-bit vertical counter, 4 equal samples */
+STATIC VOID_T test_vc_glitch_rejected(VOID_T)
+{
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    /* 3 samples low is one short of the counter */
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(25);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(sg_evt_num, 0);
+
+    /* contact bounce faster than the scan */
+    __key_bounce(KEY_A_PORT, 20, 3000);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(sg_evt_num, 0);
+
+    __key_unreg(&sg_key_a);
+}
+
+STATIC VOID_T test_vc_bouncy_press(VOID_T)
+{
+    CONST EVT_REC_T *rec;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    /* bouncing press and release edges, one press of about 200 ms */
+    __key_bounce(KEY_A_PORT, 9, 3000);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(200);
+    __key_bounce(KEY_A_PORT, 8, 3000);
+    sim_run_ms(200);
+
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_DOWN), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_UP), 1);
+    rec = __evt_find(&sg_key_a, KEY_UP);
+    TEST_CHECK(rec != NULL);
+    if (rec != NULL) {
+        TEST_CHECK((rec->evt.duration >= 190) && (rec->evt.duration <= 260));
+    }
+
+    __key_unreg(&sg_key_a);
+}
+
+STATIC VOID_T test_vc_keys_independent(VOID_T)
+{
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_def_set(&sg_key_b, KEY_B_PORT, __key_b_evt_cb);
+    __key_reg(&sg_key_a);
+    __key_reg(&sg_key_b);
+    __case_start();
+
+    /* key b bounces while key a is held, the shared counter keeps them apart */
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(20);
+    __key_bounce(KEY_B_PORT, 12, 4000);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(200);
+
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_DOWN), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_UP), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_b, KEY_DOWN), 0);
+
+    __key_unreg(&sg_key_a);
+    __key_unreg(&sg_key_b);
+}
+
+/* a table is registered completely or not at all */
+STATIC VOID_T test_table_missing_pin(VOID_T)
+{
+    KEY_DEF_T tab[2];
+    KEY_HANDLE handle;
+
+    __key_def_set(&tab[0], KEY_A_PORT, __key_a_evt_cb);
+    /* PA2 is not bonded out */
+    __key_def_set(&tab[1], TY_GPIOA_2, __key_b_evt_cb);
+    TEST_CHECK_EQ(tuya_reg_key_table(tab, KEY_TAB_SIZE(tab)), KEY_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_key_get_handle(&tab[0], &handle), KEY_ERR_INVALID_PARM);
+
+    /* all key ids are still free */
+    __key_def_set(&tab[1], KEY_B_PORT, __key_b_evt_cb);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_pin_set(KEY_B_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key_table(tab, KEY_TAB_SIZE(tab)), KEY_OK);
+    __case_start();
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(sg_evt_num, 3);
+
+    __key_unreg(&tab[0]);
+    __key_unreg(&tab[1]);
+}
+
+/* auto-repeat, the press is short if it is released before the first repeat */
+STATIC VOID_T test_repeat_short_on_release(VOID_T)
+{
+    CONST EVT_REC_T *rec;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.repeat_delay = 500;
+    sg_key_a.repeat_intv = 100;
+    sg_key_a.repeat_intv_min = 5;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_ERR_INVALID_PARM);
+    sg_key_a.repeat_intv_min = 20;
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 0);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    rec = __evt_find(&sg_key_a, SHORT_PRESS);
+    TEST_CHECK((rec != NULL) && (rec->evt.duration >= 190));
+
+    /* held: repeats only */
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(1000);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 0);
+    TEST_CHECK(__evt_cnt(&sg_key_a, HOLD_REPEAT) >= 6);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* multi-click: a held press is no click, it ends the sequence */
+STATIC VOID_T test_click_long_hold(VOID_T)
+{
+    CONST EVT_REC_T *rec;
+    UINT_T release;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.click_max = 2;
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    /* two taps */
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, DOUBLE_CLICK), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 0);
+
+    /* a tap, then a 3 s hold: the tap is sent while held, the hold gives nothing */
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(3000);
+    release = sim_time_us() / 1000;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, DOUBLE_CLICK), 0);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    rec = __evt_find(&sg_key_a, SHORT_PRESS);
+    TEST_CHECK((rec != NULL) && (rec->rx_ms < release));
+
+    /* a hold alone is no click either */
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(1500);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 0);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_UP), 1);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* an update moves a key to another pin or source, a refused one keeps the old define */
+STATIC VOID_T test_key_update(VOID_T)
+{
+    KEY_HANDLE handle, handle_b;
+    UCHAR_T i;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_def_set(&sg_key_b, KEY_B_PORT, __key_b_evt_cb);
+    __key_reg(&sg_key_a);
+    __key_reg(&sg_key_b);
+    __case_start();
+    TEST_CHECK_EQ(tuya_key_get_handle(&sg_key_a, &handle), KEY_OK);
+
+    /* the pin of another key is refused, the key stays on its pin */
+    sg_key_upd[0] = sg_key_a;
+    sg_key_upd[0].port = KEY_B_PORT;
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[0]), KEY_ERR_INVALID_PARM);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+
+    /* to a new pin, the old one is no longer scanned */
+    sg_evt_num = 0;
+    sg_key_upd[0].port = KEY_D_PORT;
+    sim_pin_set(KEY_D_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[0]), KEY_OK);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(sg_evt_num, 0);
+    sim_pin_set(KEY_D_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_D_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+
+    /* both source banks in use, moving from one source to a third frees the old bank */
+    sg_key_upd_b = sg_key_b;
+    sg_key_upd_b.src = &sg_key_src[0];
+    TEST_CHECK_EQ(tuya_key_get_handle(&sg_key_b, &handle_b), KEY_OK);
+    TEST_CHECK_EQ(tuya_key_update(handle_b, &sg_key_upd_b), KEY_OK);
+    sg_key_upd[1] = sg_key_upd[0];
+    sg_key_upd[1].src = &sg_key_src[1];
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[1]), KEY_OK);
+    sg_key_upd[2] = sg_key_upd[0];
+    sg_key_upd[2].src = &sg_key_src[2];
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[2]), KEY_OK);
+
+    sg_evt_num = 0;
+    for (i = 0; i < 3; i++) {
+        sg_src_state[i] = 1;
+        sim_run_ms(100);
+        sg_src_state[i] = 0;
+        sim_run_ms(500);
+    }
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_b, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(sg_evt_num, 6);
+
+    TEST_CHECK_EQ(tuya_unreg_key(handle), KEY_OK);
+    TEST_CHECK_EQ(tuya_unreg_key(handle_b), KEY_OK);
+
+    /* the handle of an unregistered key stays invalid when its slot is used again */
+    __key_reg(&sg_key_a);
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[0]), KEY_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_unreg_key(handle), KEY_ERR_INVALID_PARM);
+    __key_unreg(&sg_key_a);
+}
+
+/* the callbacks run from the main loop, a full queue drops and counts the newest events */
+STATIC VOID_T test_event_queue_overflow(VOID_T)
+{
+    KEY_SCAN_STAT_T stat;
+    UCHAR_T i;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_reg(&sg_key_a);
+    __case_start();
+    tuya_key_clr_scan_stat();
+
+    /* 8 taps of 3 events each without the main loop */
+    sim_set_loop(NULL);
+    for (i = 0; i < 8; i++) {
+        sim_pin_set(KEY_A_PORT, FALSE);
+        sim_run_ms(100);
+        sim_pin_set(KEY_A_PORT, TRUE);
+        sim_run_ms(100);
+    }
+    TEST_CHECK_EQ(sg_evt_num, 0);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK_EQ(stat.evt_depth_max, KEY_EVENT_QUEUE_SIZE);
+    TEST_CHECK_EQ(stat.evt_overflow_cnt, 8 * 3 - KEY_EVENT_QUEUE_SIZE);
+
+    /* the queued events come in order, then the queue takes new ones */
+    sim_set_loop(tuya_key_loop);
+    sim_run_ms(10);
+    TEST_CHECK_EQ(sg_evt_num, KEY_EVENT_QUEUE_SIZE);
+    for (i = 0; i < KEY_EVENT_QUEUE_SIZE; i++) {
+        TEST_CHECK_EQ(sg_evt_rec[i].evt.type, (i % 3 == 0) ? KEY_DOWN : ((i % 3 == 1) ? SHORT_PRESS : KEY_UP));
+    }
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(sg_evt_num, 3);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK_EQ(stat.evt_overflow_cnt, 8 * 3 - KEY_EVENT_QUEUE_SIZE);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* a long press table of four levels: crossed levels while held, the highest one on release */
+STATIC VOID_T test_long_press_table(VOID_T)
+{
+    STATIC CONST UINT_T long_tab[KEY_LONG_PRESS_LEVEL_MAX + 1] = {500, 1000, 1500, 2000, 2500, 3000, 3500, 4000, 4500};
+    STATIC CONST UINT_T bad_tab[3] = {500, 1500, 1000};
+    CONST EVT_REC_T *rec;
+    UINT_T release;
+    UCHAR_T i;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.long_press_tab = long_tab;
+    sg_key_a.long_press_num = KEY_LONG_PRESS_LEVEL_MAX + 1;
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_ERR_INVALID_PARM);
+    sg_key_a.long_press_tab = bad_tab;
+    sg_key_a.long_press_num = 3;
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_ERR_INVALID_PARM);
+    sg_key_a.long_press_tab = long_tab;
+    sg_key_a.long_press_num = 4;
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    /* released between the 2nd and 3rd level */
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(1200);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_LEVEL_CROSSED), 2);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_LEVEL(1)), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_LEVEL(0)), 0);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 0);
+    rec = __evt_find(&sg_key_a, LONG_PRESS_FOR_LEVEL(1));
+    TEST_CHECK((rec != NULL) && (rec->evt.level == 2));
+
+    /* past the last level: it fires while held, every level is crossed once */
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(2500);
+    release = sim_time_us() / 1000;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_LEVEL_CROSSED), 4);
+    for (i = 0, rec = sg_evt_rec; i < sg_evt_num; i++, rec++) {
+        if (KEY_LEVEL_CROSSED == rec->evt.type) {
+            TEST_CHECK((rec->evt.duration >= long_tab[rec->evt.level - 1]) &&
+                       (rec->evt.duration < long_tab[rec->evt.level - 1] + 20));
+        }
+    }
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_LEVEL(3)), 1);
+    rec = __evt_find(&sg_key_a, LONG_PRESS_FOR_LEVEL(3));
+    TEST_CHECK((rec != NULL) && (rec->rx_ms < release));
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_LEVEL(2)), 0);
+
+    /* released before the first level */
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(300);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_LEVEL_CROSSED), 0);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* hold times follow the clock when the scan timer is late, the lateness is reported */
+STATIC VOID_T test_tick_drift(VOID_T)
+{
+    KEY_SCAN_STAT_T stat;
+    CONST EVT_REC_T *rec;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.long_press_time1 = 1000;
+    __key_reg(&sg_key_a);
+    __case_start();
+    tuya_key_clr_scan_stat();
+
+    /* 1500 ms press, 500 ms of it with the main loop blocked */
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(300);
+    sim_stall_ms(500);
+    sim_run_ms(700);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK((stat.tick_drift_max >= 490) && (stat.tick_drift_max <= 500));
+    TEST_CHECK(stat.tick_drift_last <= 1);
+    rec = __evt_find(&sg_key_a, KEY_LEVEL_CROSSED);
+    TEST_CHECK((rec != NULL) && (rec->evt.duration >= 1000) && (rec->evt.duration < 1020));
+    rec = __evt_find(&sg_key_a, KEY_UP);
+    TEST_CHECK((rec != NULL) && (rec->evt.duration >= 1480) && (rec->evt.duration <= 1520));
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_TIME1), 1);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* key_cb gets the same press types as evt_cb, without KEY_DOWN, KEY_UP and KEY_LEVEL_CROSSED */
+STATIC VOID_T test_key_cb_compat(VOID_T)
+{
+    STATIC CONST KEY_PRESS_TYPE_E press_type[3] = {SHORT_PRESS, LONG_PRESS_FOR_TIME1, LONG_PRESS_FOR_TIME2};
+    UCHAR_T i, j;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_def_set(&sg_key_b, KEY_B_PORT, NULL);
+    sg_key_a.long_press_time1 = sg_key_b.long_press_time1 = 1000;
+    sg_key_a.long_press_time2 = sg_key_b.long_press_time2 = 2000;
+    sg_key_b.key_cb = __key_b_cb;
+    __key_reg(&sg_key_a);
+    __key_reg(&sg_key_b);
+    __case_start();
+
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_pin_set(KEY_B_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_pin_set(KEY_B_PORT, TRUE);
+    sim_run_ms(300);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_pin_set(KEY_B_PORT, FALSE);
+    sim_run_ms(1500);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_pin_set(KEY_B_PORT, TRUE);
+    sim_run_ms(300);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_pin_set(KEY_B_PORT, FALSE);
+    sim_run_ms(2500);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_pin_set(KEY_B_PORT, TRUE);
+    sim_run_ms(300);
+
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_DOWN), 3);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_UP), 3);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_LEVEL_CROSSED), 3);
+    /* the press types of both keys in the same order */
+    for (i = 0, j = 0; i < sg_evt_num; i++) {
+        if (sg_evt_rec[i].key != &sg_key_b) {
+            continue;
+        }
+        TEST_CHECK((j < 3) && (sg_evt_rec[i].evt.type == press_type[j]));
+        j++;
+    }
+    TEST_CHECK_EQ(j, 3);
+    for (i = 0; i < 3; i++) {
+        TEST_CHECK_EQ(__evt_cnt(&sg_key_a, press_type[i]), 1);
+    }
+
+    /* with both callbacks only evt_cb is called */
+    __key_unreg(&sg_key_a);
+    sg_key_a.key_cb = __key_b_cb;
+    __key_reg(&sg_key_a);
+    sg_evt_num = 0;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(300);
+    TEST_CHECK_EQ(sg_evt_num, 3);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+
+    __key_unreg(&sg_key_a);
+    __key_unreg(&sg_key_b);
+}
+
+/* idle banks are sampled every KEY_SCAN_IDLE_DIV ticks, a bank with a key held every tick */
+STATIC VOID_T test_idle_bank_div(VOID_T)
+{
+    KEY_SCAN_STAT_T stat;
+    CONST EVT_REC_T *rec;
+    UINT_T skip, press;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    __key_def_set(&sg_key_c, KEY_C_PORT, __key_c_evt_cb);
+    __key_reg(&sg_key_a);
+    __key_reg(&sg_key_c);
+    __case_start();
+
+    /* two idle banks */
+    tuya_key_clr_scan_stat();
+    sim_run_ms(1000);
+    tuya_key_get_scan_stat(&stat);
+    skip = 2 * stat.scan_cnt * (KEY_SCAN_IDLE_DIV - 1) / KEY_SCAN_IDLE_DIV;
+    TEST_CHECK((stat.bank_skip_cnt + 2 >= skip) && (stat.bank_skip_cnt <= skip + 2));
+
+    /* a press is still seen within a tick of the skipped samples */
+    press = sim_time_us() / 1000;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(100);
+    rec = __evt_find(&sg_key_a, KEY_DOWN);
+    TEST_CHECK((rec != NULL) && (rec->rx_ms - press <= 40 + 10 * KEY_SCAN_IDLE_DIV));
+
+    /* bank of the held key sampled every tick */
+    tuya_key_clr_scan_stat();
+    sim_run_ms(1000);
+    tuya_key_get_scan_stat(&stat);
+    skip = stat.scan_cnt * (KEY_SCAN_IDLE_DIV - 1) / KEY_SCAN_IDLE_DIV;
+    TEST_CHECK((stat.bank_skip_cnt + 1 >= skip) && (stat.bank_skip_cnt <= skip + 1));
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_UP), 1);
+
+    __key_unreg(&sg_key_a);
+    __key_unreg(&sg_key_c);
+}
+
+/* non-default debounce algorithms on a bouncing contact */
+STATIC VOID_T test_debounce_bounce_trace(VOID_T)
+{
+    CONST KEY_DEBOUNCE_E algo[] = {KEY_DEBOUNCE_INTEGRATOR, KEY_DEBOUNCE_SHIFT, KEY_DEBOUNCE_LOCKOUT};
+    UCHAR_T i;
+
+    for (i = 0; i < SIZEOF(algo) / SIZEOF(algo[0]); i++) {
+        __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+        sg_key_a.debounce = algo[i];
+        sg_key_a.debounce_ms = 20;
+        __key_reg(&sg_key_a);
+        __case_start();
+
+        __key_bounce(KEY_A_PORT, 9, 3000);
+        sim_pin_set(KEY_A_PORT, FALSE);
+        sim_run_ms(200);
+        __key_bounce(KEY_A_PORT, 8, 3000);
+        sim_run_ms(200);
+        TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_DOWN), 1);
+        TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+        TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_UP), 1);
+
+        __key_unreg(&sg_key_a);
+    }
+}
+
+/* the short press of a key with its own debounce needs no 50 ms hold, while held or on release */
+STATIC VOID_T test_debounce_short_threshold(VOID_T)
+{
+    CONST EVT_REC_T *rec;
+    UINT_T start;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.debounce = KEY_DEBOUNCE_INTEGRATOR;
+    sg_key_a.debounce_ms = 20;
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    /* a tap just over the debounce time */
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(30);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+
+    /* a long press: sent once debounced, not 50 ms later */
+    sg_evt_num = 0;
+    start = sim_time_us() / 1000;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(200);
+    rec = __evt_find(&sg_key_a, SHORT_PRESS);
+    TEST_CHECK((rec != NULL) && ((rec->rx_ms - start) <= 40));
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* the adaptive debounce learns the bounce span of the contact, a clean contact gets faster */
+STATIC VOID_T test_debounce_adaptive(VOID_T)
+{
+    KEY_BOUNCE_STAT_T stat;
+    UCHAR_T i;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.debounce = KEY_DEBOUNCE_INTEGRATOR;
+    sg_key_a.debounce_ms = 20;
+    sg_key_a.debounce_min_ms = 10;
+    sg_key_a.debounce_max_ms = 200;
+    __key_reg(&sg_key_a);
+    __case_start();
+
+    /* clean presses: one edge per transition, down to the lower bound */
+    for (i = 0; i < 6; i++) {
+        sim_pin_set(KEY_A_PORT, FALSE);
+        sim_run_ms(200);
+        sim_pin_set(KEY_A_PORT, TRUE);
+        sim_run_ms(200);
+        TEST_CHECK_EQ(tuya_key_get_bounce_stat(&sg_key_a, &stat), KEY_OK);
+        TEST_CHECK_EQ(stat.edge_cnt_last, 1);
+        TEST_CHECK(stat.debounce_ms <= 20);
+    }
+    TEST_CHECK_EQ(stat.debounce_ms, 10);
+    TEST_CHECK_EQ(stat.span_max, 0);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 6);
+
+    /* a contact bouncing for about 40 ms on press and release, an edge in every 10 ms scan tick */
+    for (i = 0; i < 10; i++) {
+        __key_bounce(KEY_A_PORT, 5, 10000);
+        sim_pin_set(KEY_A_PORT, FALSE);
+        sim_run_ms(300);
+        __key_bounce(KEY_A_PORT, 4, 10000);
+        sim_run_ms(300);
+    }
+    TEST_CHECK_EQ(tuya_key_get_bounce_stat(&sg_key_a, &stat), KEY_OK);
+    TEST_CHECK(stat.edge_cnt_max > 1);
+    /* the average of the 30 to 40 ms spans seen by the scan ticks, plus a tick */
+    TEST_CHECK((stat.debounce_ms >= 30) && (stat.debounce_ms <= 100));
+    /* learned: one press for the bouncing contact */
+    sg_evt_num = 0;
+    __key_bounce(KEY_A_PORT, 5, 10000);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(300);
+    __key_bounce(KEY_A_PORT, 4, 10000);
+    sim_run_ms(300);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, KEY_DOWN), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* SHORT_PRESS on press for a key with a long press, retracted if the press becomes long */
+STATIC VOID_T test_short_press_early(VOID_T)
+{
+    CONST EVT_REC_T *rec;
+    KEY_SCAN_STAT_T stat;
+    UINT_T start;
+
+    __key_def_set(&sg_key_a, KEY_A_PORT, __key_a_evt_cb);
+    sg_key_a.long_press_time1 = 1000;
+    sg_key_a.short_press_early = TRUE;
+    sg_key_a.click_max = 2;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_ERR_INVALID_PARM);
+    sg_key_a.click_max = 0;
+    __key_reg(&sg_key_a);
+    __case_start();
+    tuya_key_clr_scan_stat();
+
+    /* a tap: sent once debounced and held for the min press time, not on release */
+    start = sim_time_us() / 1000;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(200);
+    rec = __evt_find(&sg_key_a, SHORT_PRESS);
+    TEST_CHECK((rec != NULL) && ((rec->rx_ms - start) <= 100));
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS_RETRACT), 0);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK((stat.early_gain_last >= 130) && (stat.early_gain_last <= 160));
+    TEST_CHECK_EQ(stat.early_gain_max, stat.early_gain_last);
+
+    /* a long press: the early SHORT_PRESS is retracted at the threshold */
+    sg_evt_num = 0;
+    start = sim_time_us() / 1000;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(1500);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    rec = __evt_find(&sg_key_a, SHORT_PRESS_RETRACT);
+    TEST_CHECK((rec != NULL) && ((rec->rx_ms - start) >= 1000) && ((rec->rx_ms - start) <= 1070));
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_TIME1), 1);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, SHORT_PRESS_RETRACT), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_a, LONG_PRESS_FOR_TIME1), 1);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK_EQ(stat.retract_cnt, 1);
+
+    __key_unreg(&sg_key_a);
+}
+
+/* a suppressing chord takes the SHORT_PRESS of a key without long press */
+STATIC VOID_T test_chord_suppress_short(VOID_T)
+{
+    STATIC KEY_CHORD_DEF_T chord;
+    CONST EVT_REC_T *rec;
+
+    __key_def_set(&sg_key_c, KEY_C_PORT, __key_c_evt_cb);
+    __key_def_set(&sg_key_d, KEY_D_PORT, __key_d_evt_cb);
+    __key_reg(&sg_key_c);
+    __key_reg(&sg_key_d);
+    memset(&chord, 0, SIZEOF(chord));
+    chord.keys[0] = &sg_key_c;
+    chord.keys[1] = &sg_key_d;
+    chord.hold_time = 100;
+    chord.suppress = TRUE;
+    chord.chord_cb = __chord_cb;
+    TEST_CHECK_EQ(tuya_reg_key_chord(&chord), KEY_OK);
+    __case_start();
+
+    /* key d pressed well before key c */
+    sim_pin_set(KEY_D_PORT, FALSE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_C_PORT, FALSE);
+    sim_run_ms(300);
+    sim_pin_set(KEY_C_PORT, TRUE);
+    sim_pin_set(KEY_D_PORT, TRUE);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(sg_chord_cnt, 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_c, SHORT_PRESS), 0);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_d, SHORT_PRESS), 0);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_c, KEY_UP), 1);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_d, KEY_UP), 1);
+
+    /* a key pressed alone still gives its SHORT_PRESS, on release */
+    sg_evt_num = 0;
+    sg_chord_cnt = 0;
+    sim_pin_set(KEY_D_PORT, FALSE);
+    sim_run_ms(150);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_d, SHORT_PRESS), 0);
+    sim_pin_set(KEY_D_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(__evt_cnt(&sg_key_d, SHORT_PRESS), 1);
+    rec = __evt_find(&sg_key_d, SHORT_PRESS);
+    TEST_CHECK((rec != NULL) && (rec->evt.duration >= 140));
+    TEST_CHECK_EQ(sg_chord_cnt, 0);
+}
+
+int main(int argc, char *argv[])
+{
+    tuya_software_timer_init();
+    sim_set_loop(tuya_key_loop);
+
+    TEST_RUN(test_vc_glitch_rejected);
+    TEST_RUN(test_vc_bouncy_press);
+    TEST_RUN(test_vc_keys_independent);
+    TEST_RUN(test_table_missing_pin);
+    TEST_RUN(test_repeat_short_on_release);
+    TEST_RUN(test_click_long_hold);
+    TEST_RUN(test_key_update);
+    TEST_RUN(test_event_queue_overflow);
+    TEST_RUN(test_long_press_table);
+    TEST_RUN(test_tick_drift);
+    TEST_RUN(test_key_cb_compat);
+    TEST_RUN(test_idle_bank_div);
+    TEST_RUN(test_debounce_bounce_trace);
+    TEST_RUN(test_debounce_short_threshold);
+    TEST_RUN(test_debounce_adaptive);
+    TEST_RUN(test_short_press_early);
+    /* the chord keys cannot be unregistered, keep it last */
+    TEST_RUN(test_chord_suppress_short);
+
+    return TEST_RESULT();
+}
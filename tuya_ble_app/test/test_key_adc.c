@@ -0,0 +1,161 @@
+/**
+ * @file test_key_adc.c
+ * @author agent
+ * @brief adc resistor ladder key driver host test
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "test.h"
+#include "sim.h"
+#include "tuya_key.h"
+#include "tuya_key_adc.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define ADC_KEY_NUM         3
+#define ADC_IDLE_MV         3300
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC CONST UINT_T sg_key_mv[ADC_KEY_NUM] = {500, 1200, 2000};
+STATIC CONST KEY_ADC_DEF_T sg_ladder = {TY_GPIOB_7, sg_key_mv, ADC_KEY_NUM, ADC_IDLE_MV, 150};
+STATIC CONST KEY_SRC_T sg_ladder_src = {tuya_key_adc_read, FALSE};
+
+STATIC KEY_DEF_T sg_key_tab[ADC_KEY_NUM];
+STATIC UCHAR_T sg_short_cnt[ADC_KEY_NUM];
+STATIC UCHAR_T sg_long_cnt[ADC_KEY_NUM];
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief count the events of a key
+ * @param[in] key: key number
+ * @param[in] type: event type
+ * @return none
+ */
+STATIC VOID_T __key_evt(IN CONST UCHAR_T key, IN CONST KEY_PRESS_TYPE_E type)
+{
+    if (SHORT_PRESS == type) {
+        sg_short_cnt[key]++;
+    } else if (LONG_PRESS_FOR_TIME1 == type) {
+        sg_long_cnt[key]++;
+    } else {
+        ;
+    }
+}
+
+STATIC VOID_T __key_cb_0(KEY_PRESS_TYPE_E type)
+{
+    __key_evt(0, type);
+}
+
+STATIC VOID_T __key_cb_1(KEY_PRESS_TYPE_E type)
+{
+    __key_evt(1, type);
+}
+
+STATIC VOID_T __key_cb_2(KEY_PRESS_TYPE_E type)
+{
+    __key_evt(2, type);
+}
+
+/**
+ * @brief clear the event counts
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __evt_clr(VOID_T)
+{
+    memset(sg_short_cnt, 0, SIZEOF(sg_short_cnt));
+    memset(sg_long_cnt, 0, SIZEOF(sg_long_cnt));
+}
+
+/* a window must not reach the idle voltage or another window */
+STATIC VOID_T test_adc_def_check(VOID_T)
+{
+    STATIC CONST UINT_T near_idle_mv[] = {500, 3050};
+    STATIC CONST UINT_T overlap_mv[] = {500, 750};
+    STATIC CONST KEY_ADC_DEF_T near_idle = {TY_GPIOB_7, near_idle_mv, 2, ADC_IDLE_MV, 150};
+    STATIC CONST KEY_ADC_DEF_T overlap = {TY_GPIOB_7, overlap_mv, 2, ADC_IDLE_MV, 150};
+    STATIC CONST KEY_ADC_DEF_T no_adc = {TY_GPIOA_0, sg_key_mv, ADC_KEY_NUM, ADC_IDLE_MV, 150};
+
+    TEST_CHECK_EQ(tuya_key_adc_init(&near_idle), KEY_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_key_adc_init(&overlap), KEY_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_key_adc_init(&no_adc), KEY_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_key_adc_init(&sg_ladder), KEY_OK);
+    TEST_CHECK_EQ(tuya_key_adc_init(&sg_ladder), KEY_ERR_INVALID_STATE);
+}
+
+/* the ladder keys through the key source */
+STATIC VOID_T test_adc_keys(VOID_T)
+{
+    UCHAR_T i;
+    KEY_ADC_STAT_T stat;
+    KEY_CALLBACK key_cb[ADC_KEY_NUM] = {__key_cb_0, __key_cb_1, __key_cb_2};
+
+    for (i = 0; i < ADC_KEY_NUM; i++) {
+        memset(&sg_key_tab[i], 0, SIZEOF(KEY_DEF_T));
+        sg_key_tab[i].key_cb = key_cb[i];
+        sg_key_tab[i].long_press_time1 = 1000;
+        sg_key_tab[i].src = &sg_ladder_src;
+        sg_key_tab[i].src_bit = i;
+    }
+    sim_adc_set_mv(ADC_IDLE_MV);
+    TEST_CHECK_EQ(tuya_reg_key_table(sg_key_tab, KEY_TAB_SIZE(sg_key_tab)), KEY_OK);
+    sim_run_ms(200);
+    __evt_clr();
+
+    /* key 1, the voltage passes the key 2 window on the way */
+    sim_adc_set_mv(2000);
+    sim_run_ms(10);
+    sim_adc_set_mv(1200);
+    sim_run_ms(300);
+    sim_adc_set_mv(ADC_IDLE_MV);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(sg_short_cnt[1], 1);
+    TEST_CHECK_EQ(sg_short_cnt[2], 0);
+    TEST_CHECK_EQ(sg_short_cnt[0], 0);
+
+    /* noise in the guard band keeps the held key */
+    __evt_clr();
+    tuya_key_adc_clr_stat();
+    sim_adc_set_mv(500);
+    sim_run_ms(600);
+    sim_adc_set_mv(850);
+    sim_run_ms(60);
+    sim_adc_set_mv(500);
+    sim_run_ms(600);
+    sim_adc_set_mv(ADC_IDLE_MV);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(sg_long_cnt[0], 1);
+    TEST_CHECK_EQ(sg_short_cnt[0], 0);
+    tuya_key_adc_get_stat(&stat);
+    TEST_CHECK(stat.guard_cnt >= 5);
+    TEST_CHECK(stat.sample_cnt > stat.guard_cnt);
+    TEST_CHECK_EQ(stat.mv_last, ADC_IDLE_MV);
+}
+
+int main(int argc, char *argv[])
+{
+    tuya_software_timer_init();
+    sim_set_loop(tuya_key_loop);
+
+    TEST_RUN(test_adc_def_check);
+    TEST_RUN(test_adc_keys);
+
+    return TEST_RESULT();
+}
@@ -0,0 +1,193 @@
+/**
+ * @file test_key_edge.c
+ * @author agent
+ * @brief key driver host test in edge scan mode
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "test.h"
+#include "sim.h"
+#include "tuya_key.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define KEY_A_PORT          TY_GPIOB_4
+#define KEY_B_PORT          TY_GPIOB_5
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC KEY_DEF_T sg_key_a;
+STATIC KEY_DEF_T sg_key_upd[2];     /* defines sg_key_a is updated to */
+STATIC UINT_T sg_short_cnt = 0;
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC VOID_T __key_a_cb(KEY_PRESS_TYPE_E type)
+{
+    if (SHORT_PRESS == type) {
+        sg_short_cnt++;
+    }
+}
+
+/**
+ * @brief press and release a key cleanly
+ * @param[in] port: key port
+ * @param[in] hold_ms: press time (ms)
+ * @param[in] gap_ms: time after the release (ms)
+ * @return none
+ */
+STATIC VOID_T __key_tap(IN CONST TY_GPIO_PORT_E port, IN CONST UINT_T hold_ms, IN CONST UINT_T gap_ms)
+{
+    sim_pin_set(port, FALSE);
+    sim_run_ms(hold_ms);
+    sim_pin_set(port, TRUE);
+    sim_run_ms(gap_ms);
+}
+
+/* no scan tick while the keys are idle, a press edge starts the scan until the key settles */
+STATIC VOID_T test_edge_scan_idle(VOID_T)
+{
+    KEY_SCAN_STAT_T stat;
+    KEY_HANDLE handle;
+
+    memset(&sg_key_a, 0, SIZEOF(KEY_DEF_T));
+    sg_key_a.port = KEY_A_PORT;
+    sg_key_a.active_low = TRUE;
+    sg_key_a.key_cb = __key_a_cb;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_OK);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+    sg_short_cnt = 0;
+
+    tuya_key_clr_scan_stat();
+    sim_run_ms(10000);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK_EQ(stat.scan_cnt, 0);
+    TEST_CHECK_EQ(stat.wakeup_cnt, 0);
+
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(20);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 1);
+    sim_run_ms(80);
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(sg_short_cnt, 1);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+    tuya_key_get_scan_stat(&stat);
+    TEST_CHECK_EQ(stat.wakeup_cnt, 1);
+    /* fewer ticks than the 10 ms scan cycles of the 600 ms press and release */
+    TEST_CHECK((stat.scan_cnt > 0) && (stat.scan_cnt < 60));
+
+    TEST_CHECK_EQ(tuya_key_get_handle(&sg_key_a, &handle), KEY_OK);
+    TEST_CHECK_EQ(tuya_unreg_key(handle), KEY_OK);
+}
+
+/* the adaptive debounce closes its transitions before the scan timer stops */
+STATIC VOID_T test_edge_debounce_adaptive(VOID_T)
+{
+    KEY_BOUNCE_STAT_T stat;
+    KEY_HANDLE handle;
+    UCHAR_T i;
+
+    memset(&sg_key_a, 0, SIZEOF(KEY_DEF_T));
+    sg_key_a.port = KEY_A_PORT;
+    sg_key_a.active_low = TRUE;
+    sg_key_a.key_cb = __key_a_cb;
+    sg_key_a.debounce = KEY_DEBOUNCE_INTEGRATOR;
+    sg_key_a.debounce_ms = 20;
+    sg_key_a.debounce_min_ms = 10;
+    sg_key_a.debounce_max_ms = 200;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_OK);
+    sim_run_ms(500);
+    sg_short_cnt = 0;
+
+    for (i = 0; i < 6; i++) {
+        __key_tap(KEY_A_PORT, 200, 300);
+        /* the scan timer stops once the release is closed */
+        TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+        TEST_CHECK_EQ(tuya_key_get_bounce_stat(&sg_key_a, &stat), KEY_OK);
+        TEST_CHECK_EQ(stat.edge_cnt_last, 1);
+    }
+    TEST_CHECK_EQ(stat.debounce_ms, 10);
+    TEST_CHECK_EQ(stat.span_max, 0);
+    TEST_CHECK_EQ(sg_short_cnt, 6);
+
+    TEST_CHECK_EQ(tuya_key_get_handle(&sg_key_a, &handle), KEY_OK);
+    TEST_CHECK_EQ(tuya_unreg_key(handle), KEY_OK);
+}
+
+/* an update moves the press interrupt with the key */
+STATIC VOID_T test_edge_key_update(VOID_T)
+{
+    KEY_HANDLE handle;
+
+    memset(&sg_key_a, 0, SIZEOF(KEY_DEF_T));
+    sg_key_a.port = KEY_A_PORT;
+    sg_key_a.active_low = TRUE;
+    sg_key_a.key_cb = __key_a_cb;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_pin_set(KEY_B_PORT, TRUE);
+    TEST_CHECK_EQ(tuya_reg_key(&sg_key_a), KEY_OK);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(tuya_key_get_handle(&sg_key_a, &handle), KEY_OK);
+
+    /* same pin, now active high */
+    sg_key_upd[0] = sg_key_a;
+    sg_key_upd[0].active_low = FALSE;
+    sim_pin_set(KEY_A_PORT, FALSE);
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[0]), KEY_OK);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+    sg_short_cnt = 0;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    sim_run_ms(500);
+    TEST_CHECK_EQ(sg_short_cnt, 1);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+
+    /* another pin, the old one no longer wakes the scan */
+    sg_key_upd[1] = sg_key_a;
+    sg_key_upd[1].port = KEY_B_PORT;
+    TEST_CHECK_EQ(tuya_key_update(handle, &sg_key_upd[1]), KEY_OK);
+    sim_run_ms(500);
+    sg_short_cnt = 0;
+    sim_pin_set(KEY_A_PORT, TRUE);
+    sim_run_ms(100);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+    sim_pin_set(KEY_A_PORT, FALSE);
+    __key_tap(KEY_B_PORT, 100, 500);
+    TEST_CHECK_EQ(sg_short_cnt, 1);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+
+    TEST_CHECK_EQ(tuya_unreg_key(handle), KEY_OK);
+}
+
+int main(int argc, char *argv[])
+{
+    tuya_software_timer_init();
+    sim_set_loop(tuya_key_loop);
+    TEST_CHECK_EQ(tuya_key_set_scan_mode(KEY_SCAN_MODE_EDGE), KEY_OK);
+
+    TEST_RUN(test_edge_scan_idle);
+    TEST_RUN(test_edge_debounce_adaptive);
+    TEST_RUN(test_edge_key_update);
+
+    return TEST_RESULT();
+}
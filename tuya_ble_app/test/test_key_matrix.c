@@ -0,0 +1,174 @@
+/**
+ * @file test_key_matrix.c
+ * @author agent
+ * @brief matrix keypad driver host test
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include <string.h>
+#include "test.h"
+#include "sim.h"
+#include "tuya_key.h"
+#include "tuya_key_matrix.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define ROW_NUM             2
+#define COL_NUM             2
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC CONST TY_GPIO_PORT_E sg_row_port[ROW_NUM] = {TY_GPIOB_6, TY_GPIOB_7};
+STATIC CONST TY_GPIO_PORT_E sg_col_port[COL_NUM] = {TY_GPIOC_0, TY_GPIOC_1};
+STATIC CONST KEY_MATRIX_DEF_T sg_matrix = {sg_row_port, ROW_NUM, sg_col_port, COL_NUM};
+STATIC CONST KEY_SRC_T sg_matrix_src = {tuya_key_matrix_read, TRUE};
+
+STATIC BOOL_T sg_key_down[ROW_NUM][COL_NUM];    /* board: pressed keys */
+STATIC UCHAR_T sg_short_cnt[ROW_NUM * COL_NUM];
+STATIC KEY_DEF_T sg_key_tab[ROW_NUM * COL_NUM];
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+/**
+ * @brief board model: a pressed key pulls its column to the row output
+ * @param[in] none
+ * @return none
+ */
+STATIC VOID_T __board_update(VOID_T)
+{
+    UCHAR_T row, col, level = 0xFF;
+
+    for (row = 0; row < ROW_NUM; row++) {
+        for (col = 0; col < COL_NUM; col++) {
+            if (sg_key_down[row][col] && !sim_pin_get_out(sg_row_port[row])) {
+                level &= ~TY_GPIO_PORT_TO_MASK(sg_col_port[col]);
+            }
+        }
+    }
+    sim_bank_drive(TY_GPIO_BANK_C, TY_GPIO_PORT_TO_MASK(sg_col_port[0]) | TY_GPIO_PORT_TO_MASK(sg_col_port[1]), level);
+}
+
+STATIC VOID_T __key_cb_0(KEY_PRESS_TYPE_E type)
+{
+    sg_short_cnt[0] += (SHORT_PRESS == type);
+}
+
+STATIC VOID_T __key_cb_1(KEY_PRESS_TYPE_E type)
+{
+    sg_short_cnt[1] += (SHORT_PRESS == type);
+}
+
+STATIC VOID_T __key_cb_2(KEY_PRESS_TYPE_E type)
+{
+    sg_short_cnt[2] += (SHORT_PRESS == type);
+}
+
+STATIC VOID_T __key_cb_3(KEY_PRESS_TYPE_E type)
+{
+    sg_short_cnt[3] += (SHORT_PRESS == type);
+}
+
+/**
+ * @brief scan wakeups since the last call
+ * @param[in] none
+ * @return wakeups
+ */
+STATIC UINT_T __wakeup_cnt(VOID_T)
+{
+    KEY_SCAN_STAT_T stat;
+
+    tuya_key_get_scan_stat(&stat);
+    tuya_key_clr_scan_stat();
+    return stat.wakeup_cnt;
+}
+
+/* a failed init leaves nothing behind */
+STATIC VOID_T test_matrix_init_failed(VOID_T)
+{
+    STATIC CONST TY_GPIO_PORT_E bad_row[ROW_NUM] = {TY_GPIOB_4, TY_GPIOB_5};
+    STATIC CONST TY_GPIO_PORT_E bad_col[COL_NUM] = {TY_GPIOC_0, TY_GPIOC_5};   /* PC5 is not bonded out */
+    STATIC CONST KEY_MATRIX_DEF_T bad_matrix = {bad_row, ROW_NUM, bad_col, COL_NUM};
+
+    TEST_CHECK_EQ(tuya_key_matrix_init(&bad_matrix), KEY_ERR_INVALID_PARM);
+    TEST_CHECK_EQ(tuya_key_matrix_init(&sg_matrix), KEY_OK);
+
+    /* the rows of the failed define are not driven by the sweep */
+    tuya_gpio_init(TY_GPIOB_4, FALSE, TRUE);
+    tuya_gpio_write(TY_GPIOB_4, TRUE);
+    tuya_key_matrix_read();
+    TEST_CHECK(sim_pin_get_out(TY_GPIOB_4));
+}
+
+/* the sweep of a held key raises no column wakeups */
+STATIC VOID_T test_matrix_sweep_no_wakeup(VOID_T)
+{
+    UCHAR_T i;
+    KEY_CALLBACK key_cb[ROW_NUM * COL_NUM] = {__key_cb_0, __key_cb_1, __key_cb_2, __key_cb_3};
+
+    for (i = 0; i < ROW_NUM * COL_NUM; i++) {
+        memset(&sg_key_tab[i], 0, SIZEOF(KEY_DEF_T));
+        sg_key_tab[i].key_cb = key_cb[i];
+        sg_key_tab[i].src = &sg_matrix_src;
+        sg_key_tab[i].src_bit = KEY_MATRIX_BIT(i / COL_NUM, i % COL_NUM, COL_NUM);
+    }
+    TEST_CHECK_EQ(tuya_reg_key_table(sg_key_tab, KEY_TAB_SIZE(sg_key_tab)), KEY_OK);
+    sim_run_ms(200);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+    __wakeup_cnt();
+
+    /* one wakeup for the press, none from the sweeps while held */
+    sg_key_down[1][0] = TRUE;
+    sim_run_ms(500);
+    TEST_CHECK_EQ(__wakeup_cnt(), 1);
+    sg_key_down[1][0] = FALSE;
+    sim_run_ms(300);
+    TEST_CHECK_EQ(sg_short_cnt[2], 1);
+    TEST_CHECK_EQ(__wakeup_cnt(), 0);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+
+    /* the idle matrix wakes up again */
+    sg_key_down[0][1] = TRUE;
+    sim_run_ms(100);
+    sg_key_down[0][1] = FALSE;
+    sim_run_ms(300);
+    TEST_CHECK_EQ(sg_short_cnt[1], 1);
+    TEST_CHECK_EQ(__wakeup_cnt(), 1);
+
+    /* a key of a held column */
+    sg_key_down[0][0] = TRUE;
+    sim_run_ms(100);
+    sg_key_down[1][0] = TRUE;
+    sim_run_ms(100);
+    sg_key_down[0][0] = FALSE;
+    sg_key_down[1][0] = FALSE;
+    sim_run_ms(300);
+    TEST_CHECK_EQ(sg_short_cnt[0], 1);
+    TEST_CHECK_EQ(sg_short_cnt[2], 2);
+    TEST_CHECK_EQ(sim_soft_timer_num(), 0);
+}
+
+int main(int argc, char *argv[])
+{
+    tuya_software_timer_init();
+    sim_set_board(__board_update);
+    sim_set_loop(tuya_key_loop);
+    tuya_key_set_scan_mode(KEY_SCAN_MODE_EDGE);
+
+    TEST_RUN(test_matrix_init_failed);
+    TEST_RUN(test_matrix_sweep_no_wakeup);
+
+    return TEST_RESULT();
+}
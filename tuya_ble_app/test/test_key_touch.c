@@ -0,0 +1,151 @@
+/**
+ * @file test_key_touch.c
+ * @author agent
+ * @brief capacitive touch key driver host test
+ * @version 1.0
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) tuya.inc 2026
+ *
+ */
+
+#include "test.h"
+#include "sim.h"
+#include "tuya_key_touch.h"
+
+/***********************************************************
+************************micro define************************
+***********************************************************/
+#define TOUCH_CH_NUM        2
+#define TOUCH_IDLE_CNT      1000
+
+/***********************************************************
+***********************typedef define***********************
+***********************************************************/
+
+/***********************************************************
+***********************variable define**********************
+***********************************************************/
+TEST_DEFINE();
+
+STATIC UINT_T sg_count[TOUCH_CH_NUM] = {TOUCH_IDLE_CNT, TOUCH_IDLE_CNT};
+
+/***********************************************************
+***********************function define**********************
+***********************************************************/
+STATIC UINT_T __touch_read(UCHAR_T ch)
+{
+    return sg_count[ch];
+}
+
+/**
+ * @brief read the channels a number of times, one baseline update each
+ * @param[in] num: reads
+ * @return key states of the last read
+ */
+STATIC UINT_T __touch_read_n(IN CONST UINT_T num)
+{
+    UINT_T i, state = 0;
+
+    for (i = 0; i < num; i++) {
+        state = tuya_key_touch_read();
+    }
+    return state;
+}
+
+/**
+ * @brief get the baseline of a channel
+ * @param[in] ch: channel
+ * @return baseline
+ */
+STATIC UINT_T __baseline(IN CONST UCHAR_T ch)
+{
+    KEY_TOUCH_CH_INFO_T info;
+
+    TEST_CHECK_EQ(tuya_key_touch_get_ch_info(ch, &info), KEY_OK);
+    return info.baseline;
+}
+
+/* slow baselines up to 1/256 per update, the baselines start from the first counts */
+STATIC VOID_T test_touch_init(VOID_T)
+{
+    STATIC KEY_TOUCH_DEF_T touch = {__touch_read, TOUCH_CH_NUM, 60, 20, 9};
+
+    TEST_CHECK_EQ(tuya_key_touch_init(&touch), KEY_ERR_INVALID_PARM);
+    touch.baseline_shift = 8;
+    sg_count[0] = TOUCH_IDLE_CNT + 100;
+    TEST_CHECK_EQ(tuya_key_touch_init(&touch), KEY_OK);
+    TEST_CHECK_EQ(__baseline(0), TOUCH_IDLE_CNT + 100);
+    TEST_CHECK_EQ(__baseline(1), TOUCH_IDLE_CNT);
+}
+
+/* a channel touched at init gives no touch, after the release its baseline falls soon */
+STATIC VOID_T test_touch_start_touched(VOID_T)
+{
+    TEST_CHECK_EQ(__touch_read_n(100), 0);
+    sg_count[0] = TOUCH_IDLE_CNT;
+    __touch_read_n(100);
+    TEST_CHECK(__baseline(0) <= TOUCH_IDLE_CNT + 1);
+    sg_count[0] = TOUCH_IDLE_CNT + 100;
+    TEST_CHECK_EQ(__touch_read_n(1), 0x01);
+    sg_count[0] = TOUCH_IDLE_CNT;
+    TEST_CHECK_EQ(__touch_read_n(1), 0);
+    __touch_read_n(3000);
+}
+
+/* the baseline follows falling counts faster than rising ones */
+STATIC VOID_T test_touch_baseline_fall_fast(VOID_T)
+{
+    UINT_T up, down;
+
+    sg_count[0] = TOUCH_IDLE_CNT + 40;
+    sg_count[1] = TOUCH_IDLE_CNT - 40;
+    TEST_CHECK_EQ(__touch_read_n(200), 0);
+    up = __baseline(0) - TOUCH_IDLE_CNT;
+    down = TOUCH_IDLE_CNT - __baseline(1);
+    TEST_CHECK((up >= 20) && (up < 40));
+    TEST_CHECK(down >= 39);
+
+    /* settle both channels at the idle count again, the fraction keeps 1 count off from below */
+    sg_count[0] = TOUCH_IDLE_CNT;
+    sg_count[1] = TOUCH_IDLE_CNT;
+    __touch_read_n(3000);
+    TEST_CHECK_EQ(__baseline(0), TOUCH_IDLE_CNT);
+    TEST_CHECK(__baseline(1) + 1 >= TOUCH_IDLE_CNT);
+}
+
+/* a short dip of the count gives no touch when it comes back */
+STATIC VOID_T test_touch_dip_no_touch(VOID_T)
+{
+    sg_count[0] = TOUCH_IDLE_CNT - 30;
+    __touch_read_n(20);
+    sg_count[0] = TOUCH_IDLE_CNT;
+    TEST_CHECK_EQ(__touch_read_n(1), 0);
+    __touch_read_n(3000);
+}
+
+/* touch and release thresholds, the baseline is frozen while touched */
+STATIC VOID_T test_touch_hysteresis(VOID_T)
+{
+    UINT_T base = __baseline(1);
+
+    sg_count[1] = TOUCH_IDLE_CNT + 100;
+    TEST_CHECK_EQ(__touch_read_n(1), 0x02);
+    TEST_CHECK_EQ(__touch_read_n(500), 0x02);
+    TEST_CHECK_EQ(__baseline(1), base);
+    sg_count[1] = TOUCH_IDLE_CNT + 30;
+    TEST_CHECK_EQ(__touch_read_n(1), 0x02);
+    sg_count[1] = TOUCH_IDLE_CNT + 10;
+    TEST_CHECK_EQ(__touch_read_n(1), 0);
+}
+
+int main(int argc, char *argv[])
+{
+    TEST_RUN(test_touch_init);
+    TEST_RUN(test_touch_start_touched);
+    TEST_RUN(test_touch_baseline_fall_fast);
+    TEST_RUN(test_touch_dip_no_touch);
+    TEST_RUN(test_touch_hysteresis);
+
+    return TEST_RESULT();
+}